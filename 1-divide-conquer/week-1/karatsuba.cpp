@@ -1,141 +1,2044 @@
 #include <iostream>
 #include <string>
-#include <sstream>
 #include <map>
 #include <vector>
+#include <cassert>
+#include <cstdint>
+#include <climits>
+#include <algorithm>
+#include <cctype>
 #include <cmath>
+#include <cstdlib>
+#include <random>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define KARATSUBA_X86_KERNELS
+#endif
 
 using namespace std;
 
-int ctoi(char c)
+#pragma region Types
+// Big numbers are stored as little-endian arrays of binary limbs (index 0 is the least significant limb)
+// A double limb is wide enough to hold the full product of two limbs, plus a carry
+typedef uint32_t limb_t;
+typedef uint64_t dlimb_t;
+int const LIMB_BITS = 32;
+
+#pragma endregion
+
+#pragma region Kernels
+// Hot loops with SIMD implementations. Each has a portable scalar version, and the fastest version the CPU supports is
+// picked once at startup (see selectKernels()), so the same binary runs everywhere
+
+// r[0, n_a) = a[0, n_a) + b[0, n_b); requires n_a >= n_b. Returns the carry out of the most significant limb
+// r may alias a (or b, if they have the same length)
+limb_t addLimbsScalar(limb_t *r, limb_t const *a, int n_a, limb_t const *b, int n_b)
+{
+  dlimb_t carry = 0;
+  int i = 0;
+  for (; i < n_b; ++i)
+  {
+    carry += dlimb_t(a[i]) + b[i];
+    r[i] = limb_t(carry);
+    carry >>= LIMB_BITS;
+  }
+  for (; i < n_a; ++i)
+  {
+    carry += a[i];
+    r[i] = limb_t(carry);
+    carry >>= LIMB_BITS;
+  }
+  return limb_t(carry);
+}
+
+// r[0, n_a) = a[0, n_a) - b[0, n_b); requires n_a >= n_b. Returns the borrow out of the most significant limb, i.e. 1 if b > a
+// r may alias a (or b, if they have the same length)
+limb_t subtractLimbsScalar(limb_t *r, limb_t const *a, int n_a, limb_t const *b, int n_b)
+{
+  limb_t borrow = 0;
+  int i = 0;
+  for (; i < n_b; ++i)
+  {
+    dlimb_t d = dlimb_t(a[i]) - b[i] - borrow;
+    r[i] = limb_t(d);
+    borrow = limb_t(d >> LIMB_BITS) & 1; // wrapped around if the subtraction went below zero
+  }
+  for (; i < n_a; ++i)
+  {
+    dlimb_t d = dlimb_t(a[i]) - borrow;
+    r[i] = limb_t(d);
+    borrow = limb_t(d >> LIMB_BITS) & 1;
+  }
+  return borrow;
+}
+
+// Value of the n <= 19 ASCII digits at s, most significant first
+uint64_t parseDigitsScalar(char const *s, int n)
+{
+  uint64_t value = 0;
+  for (int i = 0; i < n; ++i)
+    value = value * 10 + (s[i] - '0');
+  return value;
+}
+
+uint64_t parse16DigitsScalar(char const *s)
+{
+  return parseDigitsScalar(s, 16);
+}
+
+// Writes value < 10^8 as exactly 8 ASCII digits, with leading zeros
+void print8DigitsScalar(uint32_t value, char *out)
+{
+  for (int i = 7; i >= 0; --i, value /= 10)
+    out[i] = '0' + value % 10;
+}
+
+#ifdef KARATSUBA_X86_KERNELS
+// Addition 8 limbs at a time, with deferred carry resolution: each lane is added without carries first, then the carries
+// between lanes are resolved all at once from two bit masks. A lane generates a carry if its sum wrapped around, and
+// propagates an incoming carry if its sum is all ones. Treating the masks as binary numbers, (2 * generate + propagate + carry in)
+// ripples every carry through the propagating lanes exactly like an adder would, and XOR-ing out the propagate bits leaves
+// one bit per lane that receives a carry, plus the carry out of the block in bit 8
+__attribute__((target("avx2"))) limb_t addLimbsAvx2(limb_t *r, limb_t const *a, int n_a, limb_t const *b, int n_b)
+{
+  __m256i const SIGN = _mm256_set1_epi32(INT_MIN);
+  __m256i const ALL_ONES = _mm256_set1_epi32(-1);
+  __m256i const ONE = _mm256_set1_epi32(1);
+  __m256i const LANE_INDEX = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+
+  unsigned carry = 0;
+  int i = 0;
+  for (; i + 8 <= n_b; i += 8)
+  {
+    __m256i va = _mm256_loadu_si256((__m256i const *)(a + i));
+    __m256i vb = _mm256_loadu_si256((__m256i const *)(b + i));
+    __m256i sum = _mm256_add_epi32(va, vb);
+    // AVX2 only has signed comparisons, so flip the sign bits to compare as unsigned: the sum wrapped iff sum < a
+    __m256i generate = _mm256_cmpgt_epi32(_mm256_xor_si256(va, SIGN), _mm256_xor_si256(sum, SIGN));
+    __m256i propagate = _mm256_cmpeq_epi32(sum, ALL_ONES);
+    unsigned g = _mm256_movemask_ps(_mm256_castsi256_ps(generate));
+    unsigned p = _mm256_movemask_ps(_mm256_castsi256_ps(propagate));
+    unsigned c = (g << 1) + p + carry;
+    unsigned carries_in = (c ^ p) & 0xFF;
+    carry = c >> 8;
+    __m256i increments = _mm256_and_si256(_mm256_srlv_epi32(_mm256_set1_epi32(carries_in), LANE_INDEX), ONE);
+    _mm256_storeu_si256((__m256i *)(r + i), _mm256_add_epi32(sum, increments));
+  }
+
+  // Finish the remaining limbs of b, and the carry through the rest of a, one limb at a time
+  dlimb_t tail_carry = carry;
+  for (; i < n_b; ++i)
+  {
+    tail_carry += dlimb_t(a[i]) + b[i];
+    r[i] = limb_t(tail_carry);
+    tail_carry >>= LIMB_BITS;
+  }
+  for (; i < n_a; ++i)
+  {
+    tail_carry += a[i];
+    r[i] = limb_t(tail_carry);
+    tail_carry >>= LIMB_BITS;
+  }
+  return limb_t(tail_carry);
+}
+
+// Subtraction 8 limbs at a time, with deferred borrow resolution, exactly like addLimbsAvx2(): a lane generates a borrow
+// if a < b, and propagates an incoming borrow if its difference is zero
+__attribute__((target("avx2"))) limb_t subtractLimbsAvx2(limb_t *r, limb_t const *a, int n_a, limb_t const *b, int n_b)
+{
+  __m256i const SIGN = _mm256_set1_epi32(INT_MIN);
+  __m256i const ZERO = _mm256_setzero_si256();
+  __m256i const ONE = _mm256_set1_epi32(1);
+  __m256i const LANE_INDEX = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+
+  unsigned borrow = 0;
+  int i = 0;
+  for (; i + 8 <= n_b; i += 8)
+  {
+    __m256i va = _mm256_loadu_si256((__m256i const *)(a + i));
+    __m256i vb = _mm256_loadu_si256((__m256i const *)(b + i));
+    __m256i difference = _mm256_sub_epi32(va, vb);
+    __m256i generate = _mm256_cmpgt_epi32(_mm256_xor_si256(vb, SIGN), _mm256_xor_si256(va, SIGN));
+    __m256i propagate = _mm256_cmpeq_epi32(difference, ZERO);
+    unsigned g = _mm256_movemask_ps(_mm256_castsi256_ps(generate));
+    unsigned p = _mm256_movemask_ps(_mm256_castsi256_ps(propagate));
+    unsigned c = (g << 1) + p + borrow;
+    unsigned borrows_in = (c ^ p) & 0xFF;
+    borrow = c >> 8;
+    __m256i decrements = _mm256_and_si256(_mm256_srlv_epi32(_mm256_set1_epi32(borrows_in), LANE_INDEX), ONE);
+    _mm256_storeu_si256((__m256i *)(r + i), _mm256_sub_epi32(difference, decrements));
+  }
+
+  // Finish the remaining limbs of b, and the borrow through the rest of a, one limb at a time
+  for (; i < n_b; ++i)
+  {
+    dlimb_t d = dlimb_t(a[i]) - b[i] - borrow;
+    r[i] = limb_t(d);
+    borrow = limb_t(d >> LIMB_BITS) & 1;
+  }
+  for (; i < n_a; ++i)
+  {
+    dlimb_t d = dlimb_t(a[i]) - borrow;
+    r[i] = limb_t(d);
+    borrow = limb_t(d >> LIMB_BITS) & 1;
+  }
+  return borrow;
+}
+
+// 16 ASCII digits to their value in a handful of multiply-adds: pairs of digits, then groups of 4, then of 8
+__attribute__((target("ssse3,sse4.1"))) uint64_t parse16DigitsSse(char const *s)
+{
+  __m128i digits = _mm_sub_epi8(_mm_loadu_si128((__m128i const *)s), _mm_set1_epi8('0'));
+  __m128i pairs = _mm_maddubs_epi16(digits, _mm_setr_epi8(10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1));
+  __m128i quads = _mm_madd_epi16(pairs, _mm_setr_epi16(100, 1, 100, 1, 100, 1, 100, 1));
+  __m128i packed = _mm_packus_epi32(quads, quads);
+  __m128i octets = _mm_madd_epi16(packed, _mm_setr_epi16(10000, 1, 10000, 1, 10000, 1, 10000, 1));
+  uint64_t high = uint32_t(_mm_cvtsi128_si32(octets));
+  uint64_t low = uint32_t(_mm_extract_epi32(octets, 1));
+  return high * 100000000 + low;
+}
+
+// value < 10^8 to 8 ASCII digits, dividing all the digit groups at once with multiply-high by reciprocals:
+// abcdefgh -> [abcd, efgh] -> [ab, cd, ef, gh] -> [a, b, c, d, e, f, g, h]
+__attribute__((target("sse2"))) void print8DigitsSse2(uint32_t value, char *out)
+{
+  __m128i quads = _mm_setr_epi16(value / 10000, value % 10000, 0, 0, 0, 0, 0, 0);
+  __m128i hundreds = _mm_srli_epi16(_mm_mulhi_epu16(quads, _mm_set1_epi16(5243)), 3); // x / 100 for x < 10^4
+  __m128i pairs = _mm_unpacklo_epi16(hundreds, _mm_sub_epi16(quads, _mm_mullo_epi16(hundreds, _mm_set1_epi16(100))));
+  __m128i tens = _mm_mulhi_epu16(pairs, _mm_set1_epi16(6554)); // x / 10 for x < 100
+  __m128i digits = _mm_unpacklo_epi16(tens, _mm_sub_epi16(pairs, _mm_mullo_epi16(tens, _mm_set1_epi16(10))));
+  __m128i ascii = _mm_packus_epi16(_mm_add_epi16(digits, _mm_set1_epi16('0')), _mm_setzero_si128());
+  _mm_storel_epi64((__m128i *)out, ascii);
+}
+#endif
+
+struct Kernels
+{
+  char const *name;
+  limb_t (*add)(limb_t *, limb_t const *, int, limb_t const *, int);
+  limb_t (*subtract)(limb_t *, limb_t const *, int, limb_t const *, int);
+  uint64_t (*parse16Digits)(char const *);
+  void (*print8Digits)(uint32_t, char *);
+};
+
+Kernels const SCALAR_KERNELS = {"scalar", addLimbsScalar, subtractLimbsScalar, parse16DigitsScalar, print8DigitsScalar};
+
+Kernels selectKernels()
+{
+  Kernels kernels = SCALAR_KERNELS;
+#ifdef KARATSUBA_X86_KERNELS
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("sse2"))
+  {
+    kernels.name = "sse2";
+    kernels.print8Digits = print8DigitsSse2;
+  }
+  if (__builtin_cpu_supports("ssse3") && __builtin_cpu_supports("sse4.1"))
+  {
+    kernels.name = "sse4.1";
+    kernels.parse16Digits = parse16DigitsSse;
+  }
+  if (__builtin_cpu_supports("avx2"))
+  {
+    kernels.name = "avx2";
+    kernels.add = addLimbsAvx2;
+    kernels.subtract = subtractLimbsAvx2;
+  }
+#endif
+  return kernels;
+}
+
+Kernels kernels = selectKernels();
+#pragma endregion
+
+#pragma region Limbs
+// r[0, n_a) = a[0, n_a) + b[0, n_b); requires n_a >= n_b. Returns the carry out of the most significant limb
+// r may alias a (or b, if they have the same length)
+limb_t addLimbs(limb_t *r, limb_t const *a, int n_a, limb_t const *b, int n_b)
+{
+  assert(n_a >= n_b);
+  return kernels.add(r, a, n_a, b, n_b);
+}
+
+// r[0, n_a) = a[0, n_a) - b[0, n_b); requires n_a >= n_b. Returns the borrow out of the most significant limb, i.e. 1 if b > a
+// r may alias a (or b, if they have the same length)
+limb_t subtractLimbs(limb_t *r, limb_t const *a, int n_a, limb_t const *b, int n_b)
+{
+  assert(n_a >= n_b);
+  return kernels.subtract(r, a, n_a, b, n_b);
+}
+
+// Three-way comparison of two limb arrays that may have different lengths (and leading zero limbs)
+int compareLimbs(limb_t const *a, int n_a, limb_t const *b, int n_b)
+{
+  for (; n_a > n_b; --n_a)
+    if (a[n_a - 1] != 0)
+      return 1;
+  for (; n_b > n_a; --n_b)
+    if (b[n_b - 1] != 0)
+      return -1;
+  for (int i = n_a - 1; i >= 0; --i)
+    if (a[i] != b[i])
+      return a[i] < b[i] ? -1 : 1;
+  return 0;
+}
+
+// r[0, n) += a[0, n) * m. Returns the limb that carries out of the most significant limb
+limb_t addMultiplyLimbs(limb_t *r, limb_t const *a, int n, limb_t m)
+{
+  dlimb_t carry = 0;
+  for (int i = 0; i < n; ++i)
+  {
+    carry += dlimb_t(a[i]) * m + r[i];
+    r[i] = limb_t(carry);
+    carry >>= LIMB_BITS;
+  }
+  return limb_t(carry);
+}
+
+// r[0, n) = a[0, n) / d. Returns the remainder
+// r may alias a
+limb_t divideLimbsBySmall(limb_t *r, limb_t const *a, int n, limb_t d)
+{
+  dlimb_t remainder = 0;
+  for (int i = n - 1; i >= 0; --i)
+  {
+    dlimb_t current = (remainder << LIMB_BITS) | a[i];
+    r[i] = limb_t(current / d);
+    remainder = current % d;
+  }
+  return limb_t(remainder);
+}
+
+// r[0, n) = |(-1)^neg_a * a + (-1)^neg_b * b| for magnitudes a and b of the same length n. Returns whether the result is negative
+// r may alias a or b
+bool addSignedLimbs(limb_t *r, limb_t const *a, bool neg_a, limb_t const *b, bool neg_b, int n)
+{
+  if (neg_a == neg_b)
+  {
+    limb_t carry = addLimbs(r, a, n, b, n);
+    assert(carry == 0);
+    return neg_a;
+  }
+
+  // Opposite signs: subtract the smaller magnitude from the larger one, which then decides the sign
+  int c = compareLimbs(a, n, b, n);
+  if (c < 0)
+  {
+    subtractLimbs(r, b, n, a, n);
+    return neg_b;
+  }
+  subtractLimbs(r, a, n, b, n);
+  return neg_a && c != 0;
+}
+
+// result[offset, n_result) += a[0, n_a), where the sum is known to fit in n_result limbs, so any limbs of a beyond the end of result must be zero
+void addLimbsAt(limb_t *result, int n_result, int offset, limb_t const *a, int n_a)
+{
+  for (; n_a > n_result - offset; --n_a)
+    assert(a[n_a - 1] == 0);
+  limb_t carry = addLimbs(result + offset, result + offset, n_result - offset, a, n_a);
+  assert(carry == 0);
+}
+#pragma endregion
+
+#pragma region Multiplication
+// Operand lengths (in limbs) at which each multiplication algorithm takes over from the one below it
+// The defaults were measured with tuneMultiplyThresholds() (run this program with --tune to re-measure on another machine)
+struct MultiplyThresholds
+{
+  int karatsuba = 32;
+  int toom3 = 200;
+  int ntt = 32000;
+};
+MultiplyThresholds multiplyThresholds;
+
+// Preallocated stack of scratch limbs for the multiplication recursion. Space is handed out and given back in LIFO order,
+// so sizing the arena once from the operand lengths lets a whole multiplication run without touching the heap
+class ScratchArena
+{
+  vector<limb_t> buffer;
+  size_t top = 0;
+
+public:
+  explicit ScratchArena(size_t n) : buffer(n)
+  { /* nothing */ }
+
+  limb_t *Allocate(size_t n)
+  {
+    assert(top + n <= buffer.size()); // the scratch size functions below must account for every allocation
+    limb_t *p = buffer.data() + top;
+    top += n;
+    return p;
+  }
+
+  // Gives back everything allocated from the arena since the frame was opened, when it goes out of scope
+  class Frame
+  {
+    ScratchArena &arena;
+    size_t top;
+
+  public:
+    Frame(ScratchArena &_arena) : arena(_arena), top(_arena.top)
+    { /* nothing */ }
+
+    ~Frame()
+    {
+      arena.top = top;
+    }
+  };
+};
+
+// Every multiplication routine below takes its temporaries from a ScratchArena, and comes with a function giving the
+// number of scratch limbs it needs (including its recursive calls), which must mirror the order of its allocations
+void multiplyNumbersOfSameLength(limb_t const *x, limb_t const *y, int n, limb_t *result, ScratchArena &arena);
+size_t sameLengthScratchSize(int n);
+
+// result[0, n_x + n_y) = x[0, n_x) * y[0, n_y), one row of limb products at a time; O(n_x * n_y). Needs no scratch
+void schoolbookMultiply(limb_t const *x, int n_x, limb_t const *y, int n_y, limb_t *result)
+{
+  fill(result, result + n_x, 0);
+  for (int j = 0; j < n_y; ++j)
+    result[n_x + j] = addMultiplyLimbs(result + j, x, n_x, y[j]);
+}
+
+// result[0, 2n) = x[0, n) * y[0, n), for n >= 2; O(n^1.585)
+void karatsubaMultiply(limb_t const *x, limb_t const *y, int n, limb_t *result, ScratchArena &arena)
+{
+  // Divide and conquer: x = a * B^h + b, y = c * B^h + d, where B is the limb base
+  // For odd n the low halves get the extra limb, so no padding is ever needed
+  int h = (n + 1) / 2; // length of the low halves b and d
+  int l = n - h;       // length of the high halves a and c; l <= h
+  limb_t const *a = x + h;
+  limb_t const *b = x;
+  limb_t const *c = y + h;
+  limb_t const *d = y;
+
+  // ac and bd land directly in their final positions, as they do not overlap
+  multiplyNumbersOfSameLength(a, c, l, result + 2 * h, arena);
+  multiplyNumbersOfSameLength(b, d, h, result, arena);
+
+  // Gauss's trick: ad + bc = (a+b)(c+d) - ac - bd, which needs only one more multiplication instead of two
+  // The sums may carry out into an extra limb, so multiply their low h limbs and fold the carries back in:
+  // (s1 + k1*B^h)(s2 + k2*B^h) = s1*s2 + (k1*s2 + k2*s1)*B^h + k1*k2*B^2h, where k1 and k2 are 0 or 1
+  ScratchArena::Frame frame(arena);
+  limb_t *sum_ab = arena.Allocate(h);
+  limb_t *sum_cd = arena.Allocate(h);
+  limb_t *middle = arena.Allocate(2 * h + 1); // (a+b)(c+d) < 4 * B^2h, so one extra limb suffices
+  limb_t carry_ab = addLimbs(sum_ab, b, h, a, l);
+  limb_t carry_cd = addLimbs(sum_cd, d, h, c, l);
+  multiplyNumbersOfSameLength(sum_ab, sum_cd, h, middle, arena);
+  middle[2 * h] = carry_ab & carry_cd;
+  if (carry_ab)
+    middle[2 * h] += addLimbs(middle + h, middle + h, h, sum_cd, h);
+  if (carry_cd)
+    middle[2 * h] += addLimbs(middle + h, middle + h, h, sum_ab, h);
+
+  // Neither subtraction can borrow, since (a+b)(c+d) >= ac + bd
+  subtractLimbs(middle, middle, 2 * h + 1, result + 2 * h, 2 * l);
+  subtractLimbs(middle, middle, 2 * h + 1, result, 2 * h);
+
+  // Add the middle term, shifted by h limbs. ad + bc < 2 * B^n, so only its low n + 1 limbs can be non-zero,
+  // and the full product always fits in 2n limbs, so the final carry is zero
+  addLimbs(result + h, result + h, n + l, middle, n + 1);
+}
+
+size_t karatsubaScratchSize(int n)
+{
+  int h = (n + 1) / 2;
+  return 4 * size_t(h) + 1 + sameLengthScratchSize(h); // ac and bd are computed before anything is allocated
+}
+
+// result[0, 2n) = x[0, n) * y[0, n), for n >= 5; O(n^1.465)
+void toom3Multiply(limb_t const *x, limb_t const *y, int n, limb_t *result, ScratchArena &arena)
+{
+  // Split into thirds: x = x2 * B^2k + x1 * B^k + x0, and likewise for y, so that the product is the polynomial
+  // r(t) = p(t) * q(t) of degree 4 evaluated at t = B^k. Its 5 coefficients are recovered from the products at
+  // t = 0, 1, -1, -2 and infinity, i.e. 5 multiplications of a third of the size instead of 9
+  int k = (n + 2) / 3;
+  int n2 = n - 2 * k; // length of the top thirds x2 and y2; 1 <= n2 <= k
+  assert(n2 >= 1);
+  int e = k + 1; // evaluations are at most 7 * B^k in magnitude, so one extra limb suffices
+  int w = 2 * e; // ...and so are their products, and everything derived from them during interpolation
+  ScratchArena::Frame frame(arena);
+
+  // Evaluate p(t) at 1, -1 and -2 (Bodrato's sequence), where the pieces are zero-padded to a common length first
+  auto evaluate = [&](limb_t const *v, limb_t *at_1, limb_t *at_minus_1, bool &at_minus_1_negative, limb_t *at_minus_2, bool &at_minus_2_negative) {
+    ScratchArena::Frame frame(arena);
+    limb_t *v0 = arena.Allocate(e), *v1 = arena.Allocate(e), *v2 = arena.Allocate(e);
+    fill(copy(v, v + k, v0), v0 + e, 0);
+    fill(copy(v + k, v + 2 * k, v1), v1 + e, 0);
+    fill(copy(v + 2 * k, v + n, v2), v2 + e, 0);
+
+    limb_t *v0_plus_v2 = arena.Allocate(e);
+    addSignedLimbs(v0_plus_v2, v0, false, v2, false, e);
+    addSignedLimbs(at_1, v0_plus_v2, false, v1, false, e);                                // p(1) = v0 + v1 + v2
+    at_minus_1_negative = addSignedLimbs(at_minus_1, v0_plus_v2, false, v1, true, e); // p(-1) = v0 - v1 + v2
+    bool negative = addSignedLimbs(at_minus_2, at_minus_1, at_minus_1_negative, v2, false, e);
+    addLimbs(at_minus_2, at_minus_2, e, at_minus_2, e);
+    at_minus_2_negative = addSignedLimbs(at_minus_2, at_minus_2, negative, v0, true, e); // p(-2) = 2(p(-1) + v2) - v0
+  };
+  limb_t *p_1 = arena.Allocate(e), *p_minus_1 = arena.Allocate(e), *p_minus_2 = arena.Allocate(e);
+  limb_t *q_1 = arena.Allocate(e), *q_minus_1 = arena.Allocate(e), *q_minus_2 = arena.Allocate(e);
+  bool p_minus_1_negative, p_minus_2_negative, q_minus_1_negative, q_minus_2_negative;
+  evaluate(x, p_1, p_minus_1, p_minus_1_negative, p_minus_2, p_minus_2_negative);
+  evaluate(y, q_1, q_minus_1, q_minus_1_negative, q_minus_2, q_minus_2_negative);
+
+  // Pointwise products. r(0) and r(infinity) land directly in their final positions, as they do not overlap
+  multiplyNumbersOfSameLength(x, y, k, result, arena);
+  multiplyNumbersOfSameLength(x + 2 * k, y + 2 * k, n2, result + 4 * k, arena);
+  fill(result + 2 * k, result + 4 * k, 0);
+  limb_t *r_1 = arena.Allocate(w), *r_minus_1 = arena.Allocate(w), *r_minus_2 = arena.Allocate(w);
+  multiplyNumbersOfSameLength(p_1, q_1, e, r_1, arena);
+  multiplyNumbersOfSameLength(p_minus_1, q_minus_1, e, r_minus_1, arena);
+  bool r_minus_1_negative = p_minus_1_negative != q_minus_1_negative;
+  multiplyNumbersOfSameLength(p_minus_2, q_minus_2, e, r_minus_2, arena);
+  bool r_minus_2_negative = p_minus_2_negative != q_minus_2_negative;
+
+  // Interpolate the middle coefficients c1, c2 and c3 (c0 = r(0) and c4 = r(infinity) are already known)
+  limb_t *c0 = arena.Allocate(w), *c4 = arena.Allocate(w);
+  fill(copy(result, result + 2 * k, c0), c0 + w, 0);
+  fill(copy(result + 4 * k, result + 2 * n, c4), c4 + w, 0);
+  limb_t *c1 = arena.Allocate(w), *c2 = arena.Allocate(w), *c3 = arena.Allocate(w);
+  bool c1_negative, c2_negative, c3_negative;
+  c3_negative = addSignedLimbs(c3, r_minus_2, r_minus_2_negative, r_1, true, w);
+  divideLimbsBySmall(c3, c3, w, 3); // (r(-2) - r(1)) / 3, which is exact
+  c1_negative = addSignedLimbs(c1, r_1, false, r_minus_1, !r_minus_1_negative, w);
+  divideLimbsBySmall(c1, c1, w, 2);                                             // (r(1) - r(-1)) / 2 = c1 + c3
+  c2_negative = addSignedLimbs(c2, r_minus_1, r_minus_1_negative, c0, true, w); // r(-1) - r(0)
+  c3_negative = addSignedLimbs(c3, c2, c2_negative, c3, !c3_negative, w);
+  divideLimbsBySmall(c3, c3, w, 2);
+  addLimbs(c4, c4, w, c4, w);
+  c3_negative = addSignedLimbs(c3, c3, c3_negative, c4, false, w); // c3 = (r(-1) - r(0) - (r(-2) - r(1)) / 3) / 2 + 2 * r(infinity)
+  divideLimbsBySmall(c4, c4, w, 2);
+  c2_negative = addSignedLimbs(c2, c2, c2_negative, c1, c1_negative, w);
+  c2_negative = addSignedLimbs(c2, c2, c2_negative, c4, true, w);      // c2 = r(-1) - r(0) + c1 + c3 - r(infinity)
+  c1_negative = addSignedLimbs(c1, c1, c1_negative, c3, !c3_negative, w); // c1 = (c1 + c3) - c3
+  assert(!c1_negative && !c2_negative && !c3_negative); // the coefficients of a product of non-negative polynomials are non-negative
+
+  // Recompose at t = B^k
+  addLimbsAt(result, 2 * n, k, c1, w);
+  addLimbsAt(result, 2 * n, 2 * k, c2, w);
+  addLimbsAt(result, 2 * n, 3 * k, c3, w);
+}
+
+size_t toom3ScratchSize(int n)
+{
+  size_t e = (n + 2) / 3 + 1;
+  // The 6 evaluations and 3 products stay live throughout, then either the 4 evaluation temporaries, the recursive
+  // products, or the 5 coefficients come on top of them
+  return 12 * e + max(10 * e, sameLengthScratchSize(e));
+}
+
+#pragma region NTT
+// Number-theoretic transform multiplication: the limbs are cut into 16-bit pieces, and the cyclic convolution of the
+// pieces is computed modulo three NTT-friendly primes, then recovered exactly with the Chinese remainder theorem.
+// A convolution coefficient is at most (transform length) * 2^32 < 2^55, well below the product of the primes (~2^86)
+struct NttPrime
+{
+  uint32_t modulus;
+  uint32_t generator; // a primitive root modulo the prime
+};
+NttPrime const NTT_PRIMES[3] = {{998244353, 3}, {167772161, 3}, {469762049, 3}};
+int const NTT_MAX_LENGTH = 1 << 23; // 998244353 = 119 * 2^23 + 1 limits the transform length the most
+int const NTT_PIECE_BITS = 16;
+static_assert(sizeof(limb_t) == sizeof(uint32_t), "transforms are carved out of the limb scratch arena");
+
+uint32_t powMod(uint64_t base, uint64_t exponent, uint32_t modulus)
+{
+  uint64_t result = 1;
+  for (base %= modulus; exponent > 0; exponent >>= 1, base = base * base % modulus)
+    if (exponent & 1)
+      result = result * base % modulus;
+  return result;
+}
+
+// In-place iterative radix-2 transform of a[0, n), where n must be a power of 2. twiddles must have room for n / 2 values
+void ntt(uint32_t *a, int n, bool inverse, NttPrime const &prime, uint32_t *twiddles)
+{
+  uint32_t const mod = prime.modulus;
+
+  // Bit-reversal permutation
+  for (int i = 1, j = 0; i < n; ++i)
+  {
+    int bit = n >> 1;
+    for (; j & bit; bit >>= 1)
+      j ^= bit;
+    j ^= bit;
+    if (i < j)
+      swap(a[i], a[j]);
+  }
+
+  for (int length = 2; length <= n; length <<= 1)
+  {
+    int half = length / 2;
+    uint32_t root = powMod(prime.generator, (mod - 1) / length, mod);
+    if (inverse)
+      root = powMod(root, mod - 2, mod);
+    twiddles[0] = 1;
+    for (int j = 1; j < half; ++j)
+      twiddles[j] = uint64_t(twiddles[j - 1]) * root % mod;
+
+    for (int i = 0; i < n; i += length)
+      for (int j = 0; j < half; ++j)
+      {
+        uint32_t u = a[i + j];
+        uint32_t v = uint64_t(a[i + j + half]) * twiddles[j] % mod;
+        a[i + j] = u + v < mod ? u + v : u + v - mod;
+        a[i + j + half] = u >= v ? u - v : u + mod - v;
+      }
+  }
+
+  if (inverse)
+  {
+    uint64_t n_inverse = powMod(n, mod - 2, mod);
+    for (int i = 0; i < n; ++i)
+      a[i] = a[i] * n_inverse % mod;
+  }
+}
+
+// Number of transform points needed to multiply operands of n_x and n_y limbs
+int nttLength(int n_x, int n_y)
+{
+  int pieces = (n_x + n_y) * (LIMB_BITS / NTT_PIECE_BITS);
+  int length = 1;
+  while (length < pieces)
+    length <<= 1;
+  return length;
+}
+
+bool nttSupports(int n_x, int n_y)
+{
+  return n_x + n_y <= NTT_MAX_LENGTH / (LIMB_BITS / NTT_PIECE_BITS);
+}
+
+int const NTT_PIECES_PER_LIMB = LIMB_BITS / NTT_PIECE_BITS;
+limb_t const NTT_PIECE_MASK = (limb_t(1) << NTT_PIECE_BITS) - 1;
+
+// a = the inverse transform of the pointwise product of the transforms a[0, length) and b[0, length) modulo the prime
+void nttPointwiseInverse(uint32_t *a, uint32_t const *b, int length, NttPrime const &prime, uint32_t *twiddles)
+{
+  for (int i = 0; i < length; ++i)
+    a[i] = uint64_t(a[i]) * b[i] % prime.modulus;
+  ntt(a, length, true, prime, twiddles);
+}
+
+// Cyclic convolution of a[0, length) and b[0, length) modulo the prime, in place into a (b is left holding its transform)
+// twiddles must have room for length / 2 values
+void nttConvolveInPlace(uint32_t *a, uint32_t *b, int length, NttPrime const &prime, uint32_t *twiddles)
+{
+  ntt(a, length, false, prime, twiddles);
+  ntt(b, length, false, prime, twiddles);
+  nttPointwiseInverse(a, b, length, prime, twiddles);
+}
+
+// Recovers the first n coefficients of a convolution from their residues modulo the 3 primes with Garner's algorithm,
+// c = r0 + m0 * (y1 + m1 * y2), and hands them to emit(coefficient) in order
+template <typename Emit>
+void garnerRecombine(uint32_t const *const residues[3], int n, Emit const &emit)
+{
+  uint32_t const m0 = NTT_PRIMES[0].modulus, m1 = NTT_PRIMES[1].modulus, m2 = NTT_PRIMES[2].modulus;
+  uint64_t const m0_inverse_mod_m1 = powMod(m0, m1 - 2, m1);
+  uint64_t const m0m1_inverse_mod_m2 = powMod(uint64_t(m0) * m1 % m2, m2 - 2, m2);
+  for (int i = 0; i < n; ++i)
+  {
+    uint64_t r0 = residues[0][i], r1 = residues[1][i], r2 = residues[2][i];
+    uint64_t y1 = (r1 + m1 - r0 % m1) * m0_inverse_mod_m1 % m1;
+    uint64_t y2 = (r2 + m2 - (r0 + m0 * y1) % m2) * m0m1_inverse_mod_m2 % m2;
+    emit(r0 + uint64_t(m0) * y1 + (unsigned __int128)(uint64_t(m0) * m1) * y2);
+  }
+}
+
+// Splits v[0, n_v) into 16-bit pieces[0, length), zero-padded, and transforms them forward modulo the prime
+void nttForward(limb_t const *v, int n_v, int length, NttPrime const &prime, uint32_t *pieces, uint32_t *twiddles)
+{
+  for (int i = 0; i < n_v; ++i)
+    for (int j = 0; j < NTT_PIECES_PER_LIMB; ++j)
+      pieces[i * NTT_PIECES_PER_LIMB + j] = (v[i] >> (j * NTT_PIECE_BITS)) & NTT_PIECE_MASK;
+  fill(pieces + n_v * NTT_PIECES_PER_LIMB, pieces + length, 0);
+  ntt(pieces, length, false, prime, twiddles);
+}
+
+// Computes the cyclic convolution of the pieces of x[0, n_x) and y[0, n_y) modulo one of the primes into residue.
+// residue and b must have room for nttLength(n_x, n_y) values, and twiddles for half as many
+void nttConvolve(limb_t const *x, int n_x, limb_t const *y, int n_y, NttPrime const &prime, uint32_t *residue, uint32_t *b, uint32_t *twiddles)
+{
+  int length = nttLength(n_x, n_y);
+  nttForward(x, n_x, length, prime, residue, twiddles);
+  nttForward(y, n_y, length, prime, b, twiddles);
+  nttPointwiseInverse(residue, b, length, prime, twiddles);
+}
+
+// result[0, n) = the convolution of 16-bit pieces whose residues modulo each of the 3 primes are given, with the carries propagated
+void nttRecombine(uint32_t const *const residues[3], int n, limb_t *result)
+{
+  fill(result, result + n, 0);
+  unsigned __int128 carry = 0;
+  int i = 0;
+  garnerRecombine(residues, n * NTT_PIECES_PER_LIMB, [&](unsigned __int128 coefficient) {
+    carry += coefficient;
+    result[i / NTT_PIECES_PER_LIMB] |= limb_t(carry & NTT_PIECE_MASK) << ((i % NTT_PIECES_PER_LIMB) * NTT_PIECE_BITS);
+    carry >>= NTT_PIECE_BITS;
+    ++i;
+  });
+  assert(carry == 0);
+}
+
+// result[0, n_x + n_y) = x[0, n_x) * y[0, n_y); O(n log n)
+void nttMultiply(limb_t const *x, int n_x, limb_t const *y, int n_y, limb_t *result, ScratchArena &arena)
+{
+  assert(nttSupports(n_x, n_y));
+  int length = nttLength(n_x, n_y);
+
+  ScratchArena::Frame frame(arena);
+  uint32_t *residues[3] = {arena.Allocate(length), arena.Allocate(length), arena.Allocate(length)};
+  uint32_t *b = arena.Allocate(length);
+  uint32_t *twiddles = arena.Allocate(length / 2);
+  for (int p = 0; p < 3; ++p)
+    nttConvolve(x, n_x, y, n_y, NTT_PRIMES[p], residues[p], b, twiddles);
+  nttRecombine(residues, n_x + n_y, result);
+}
+
+size_t nttScratchSize(int n_x, int n_y)
+{
+  size_t length = nttLength(n_x, n_y);
+  return 4 * length + length / 2; // 3 residue vectors, the second operand's transform, and the twiddle factors
+}
+#pragma endregion
+
+// result[0, 2n) = x[0, n) * y[0, n), for any n >= 1, picking the fastest algorithm for the size
+void multiplyNumbersOfSameLength(limb_t const *x, limb_t const *y, int n, limb_t *result, ScratchArena &arena)
+{
+  MultiplyThresholds const &t = multiplyThresholds;
+  if (n < max(t.karatsuba, 2))
+    schoolbookMultiply(x, n, y, n, result);
+  else if (n < max(t.toom3, 5))
+    karatsubaMultiply(x, y, n, result, arena);
+  else if (n < t.ntt || !nttSupports(n, n))
+    toom3Multiply(x, y, n, result, arena);
+  else
+    nttMultiply(x, n, y, n, result, arena);
+}
+
+size_t sameLengthScratchSize(int n)
+{
+  MultiplyThresholds const &t = multiplyThresholds;
+  if (n < max(t.karatsuba, 2))
+    return 0;
+  else if (n < max(t.toom3, 5))
+    return karatsubaScratchSize(n);
+  else if (n < t.ntt || !nttSupports(n, n))
+    return toom3ScratchSize(n);
+  else
+    return nttScratchSize(n, n);
+}
+
+// result[0, n_x + n_y) = x[0, n_x) * y[0, n_y), for any n_x, n_y >= 1
+void multiplyLimbs(limb_t const *x, int n_x, limb_t const *y, int n_y, limb_t *result, ScratchArena &arena)
+{
+  if (n_x < n_y)
+    return multiplyLimbs(y, n_y, x, n_x, result, arena);
+
+  if (n_x == n_y)
+    return multiplyNumbersOfSameLength(x, y, n_x, result, arena);
+
+  // Small operands are not worth slicing
+  if (n_y < multiplyThresholds.karatsuba)
+    return schoolbookMultiply(x, n_x, y, n_y, result);
+
+  // Unbalanced operands: rather than padding y up to the length of x, slice x into chunks as long as y and
+  // accumulate the chunk products, so that the cost is O(n_x / n_y) balanced multiplications of size n_y
+  ScratchArena::Frame frame(arena);
+  limb_t *chunk_product = arena.Allocate(2 * n_y);
+  fill(result, result + n_x + n_y, 0);
+  for (int offset = 0; offset < n_x; offset += n_y)
+  {
+    int m = min(n_y, n_x - offset); // only the last chunk can be shorter
+    if (m == n_y)
+      multiplyNumbersOfSameLength(x + offset, y, n_y, chunk_product, arena);
+    else
+      multiplyLimbs(y, n_y, x + offset, m, chunk_product, arena);
+
+    // Everything at or above offset + n_y is still zero, so only the low n_y limbs of the chunk product overlap
+    // with what has been accumulated so far; the carry out of that overlap cannot propagate past the chunk product
+    limb_t carry = addLimbs(result + offset, result + offset, n_y, chunk_product, n_y);
+    addLimbs(result + offset + n_y, chunk_product + n_y, m, &carry, 1);
+  }
+}
+
+size_t multiplyScratchSize(int n_x, int n_y)
+{
+  if (n_x < n_y)
+    swap(n_x, n_y);
+  if (n_x == n_y)
+    return sameLengthScratchSize(n_x);
+  if (n_y < multiplyThresholds.karatsuba)
+    return 0;
+
+  int last_chunk = n_x % n_y;
+  return 2 * size_t(n_y) + max(sameLengthScratchSize(n_y), last_chunk == 0 ? 0 : multiplyScratchSize(n_y, last_chunk));
+}
+
+// Multiplies with a scratch arena sized for exactly this product, which is the only heap allocation made
+void multiplyLimbs(limb_t const *x, int n_x, limb_t const *y, int n_y, limb_t *result)
+{
+  ScratchArena arena(multiplyScratchSize(n_x, n_y));
+  multiplyLimbs(x, n_x, y, n_y, result, arena);
+}
+#pragma endregion
+
+#pragma region Decimal
+// Binary to decimal conversion goes through base 10^9 "chunks" (9 decimal digits per uint32_t, least significant first),
+// so that the expensive part can be done with the same divide-and-conquer-and-multiply scheme as the parse
+limb_t const DECIMAL_CHUNK = 1000000000; // largest power of 10 that fits in a limb
+int const DECIMAL_CHUNK_DIGITS = 9;
+int const DECIMAL_BASECASE_LIMBS = 64;         // below this, converting by repeated division is fastest
+int const DECIMAL_SCHOOLBOOK_THRESHOLD = 64; // chunk products shorter than this skip the NTT
+
+// r[0, n_r) += a[0, n_a) in base 10^9, where n_a <= n_r, returning the carry out of r
+uint32_t addDecimalChunks(uint32_t *r, int n_r, uint32_t const *a, int n_a)
+{
+  assert(n_a <= n_r);
+  uint32_t carry = 0;
+  for (int i = 0; i < n_r && (i < n_a || carry); ++i)
+  {
+    uint32_t sum = r[i] + (i < n_a ? a[i] : 0) + carry; // below 2 * 10^9 + 1, which fits
+    carry = sum >= DECIMAL_CHUNK;
+    r[i] = carry ? sum - DECIMAL_CHUNK : sum;
+  }
+  return carry;
+}
+
+// result[0, n_x + n_y) = x[0, n_x) * y[0, n_y) in base 10^9; quadratic
+void schoolbookMultiplyDecimalChunks(uint32_t const *x, int n_x, uint32_t const *y, int n_y, uint32_t *result)
+{
+  fill(result, result + n_x + n_y, 0);
+  for (int i = 0; i < n_x; ++i)
+  {
+    // Each step is below 10^9 + (10^9 - 1)^2 + 10^9, so it fits in 64 bits
+    uint64_t carry = 0;
+    for (int j = 0; j < n_y; ++j)
+    {
+      uint64_t current = result[i + j] + uint64_t(x[i]) * y[j] + carry;
+      result[i + j] = uint32_t(current % DECIMAL_CHUNK);
+      carry = current / DECIMAL_CHUNK;
+    }
+    result[i + n_y] = uint32_t(carry);
+  }
+}
+
+// result[0, n_x + n_y) = x[0, n_x) * y[0, n_y) in base 10^9. The chunks are convolved directly with the 3-prime NTT (each
+// coefficient is below n * 10^18, well under the product of the primes), and the longer operand is halved while the
+// transform would be too long
+vector<uint32_t> multiplyDecimalChunks(uint32_t const *x, int n_x, uint32_t const *y, int n_y)
+{
+  if (n_x < n_y)
+    return multiplyDecimalChunks(y, n_y, x, n_x);
+
+  vector<uint32_t> result(n_x + n_y);
+  if (n_y < DECIMAL_SCHOOLBOOK_THRESHOLD)
+  {
+    schoolbookMultiplyDecimalChunks(x, n_x, y, n_y, result.data());
+    return result;
+  }
+
+  int length = 1;
+  while (length < n_x + n_y)
+    length <<= 1;
+  if (length > NTT_MAX_LENGTH)
+  {
+    int half = n_x / 2;
+    vector<uint32_t> low = multiplyDecimalChunks(x, half, y, n_y);
+    vector<uint32_t> high = multiplyDecimalChunks(x + half, n_x - half, y, n_y);
+    copy(low.begin(), low.end(), result.begin());
+    uint32_t carry = addDecimalChunks(result.data() + half, n_x - half + n_y, high.data(), high.size());
+    assert(carry == 0);
+    return result;
+  }
+
+  vector<uint32_t> residues[3], b(length), twiddles(length / 2);
+  for (int p = 0; p < 3; ++p)
+  {
+    uint32_t const modulus = NTT_PRIMES[p].modulus;
+    residues[p].assign(length, 0);
+    fill(b.begin(), b.end(), 0);
+    for (int i = 0; i < n_x; ++i)
+      residues[p][i] = x[i] % modulus;
+    for (int i = 0; i < n_y; ++i)
+      b[i] = y[i] % modulus;
+    nttConvolveInPlace(residues[p].data(), b.data(), length, NTT_PRIMES[p], twiddles.data());
+  }
+
+  uint32_t const *const residue_pointers[3] = {residues[0].data(), residues[1].data(), residues[2].data()};
+  unsigned __int128 carry = 0;
+  int i = 0;
+  garnerRecombine(residue_pointers, n_x + n_y, [&](unsigned __int128 coefficient) {
+    carry += coefficient;
+    // Split off the low 64 bits first, so that only the (small) high part needs a 128-bit division
+    uint64_t high = uint64_t(carry >> 64), low = uint64_t(carry);
+    unsigned __int128 high_quotient = high / DECIMAL_CHUNK;
+    unsigned __int128 rest = ((unsigned __int128)(high % DECIMAL_CHUNK) << 64) | low;
+    result[i++] = uint32_t(rest % DECIMAL_CHUNK);
+    carry = (high_quotient << 64) + rest / DECIMAL_CHUNK;
+  });
+  assert(carry == 0);
+  return result;
+}
+
+// Quadratic conversion of x[0, n) to exactly chunks chunks, peeling off 9 decimal digits at a time, least significant first
+void limbsToDecimalChunksBasecase(limb_t const *x, int n, uint32_t *result, int chunks)
+{
+  vector<limb_t> remaining(x, x + n);
+  for (int c = 0; c < chunks; ++c)
+  {
+    // Dividing by a compile-time constant lets the compiler replace the hardware division with a multiplication
+    dlimb_t remainder = 0;
+    for (int i = n - 1; i >= 0; --i)
+    {
+      dlimb_t current = (remainder << LIMB_BITS) | remaining[i];
+      remaining[i] = limb_t(current / DECIMAL_CHUNK);
+      remainder = current % DECIMAL_CHUNK;
+    }
+    while (n > 0 && remaining[n - 1] == 0)
+      --n;
+    result[c] = uint32_t(remainder);
+  }
+  assert(n == 0);
+}
+
+// Number of chunks needed for any value of n limbs: 32 * log10(2) < 9.64 digits per limb
+int decimalChunksFor(int n)
+{
+  return int((int64_t(n) * 964 + 899) / 900) + 1;
+}
+
+// Divide-and-conquer conversion of x[0, n) to base 10^9: the low 64 * 2^k limbs (the largest such block shorter than n)
+// and the rest are converted recursively, then combined as high * 2^(32 * 64 * 2^k) + low with the fast chunk
+// multiplication. powers[k] caches 2^(32 * 64 * 2^k) in base 10^9, which is built by repeated squaring.
+// The result may have leading zero chunks
+vector<uint32_t> limbsToDecimalChunks(limb_t const *x, int n, vector<vector<uint32_t>> &powers)
+{
+  if (n <= DECIMAL_BASECASE_LIMBS)
+  {
+    vector<uint32_t> result(decimalChunksFor(n));
+    limbsToDecimalChunksBasecase(x, n, result.data(), result.size());
+    return result;
+  }
+
+  int k = 0;
+  while ((DECIMAL_BASECASE_LIMBS << (k + 1)) < n)
+    ++k;
+  int low_length = DECIMAL_BASECASE_LIMBS << k;
+  while (int(powers.size()) <= k)
+  {
+    if (powers.empty())
+    {
+      vector<limb_t> power(DECIMAL_BASECASE_LIMBS + 1, 0);
+      power.back() = 1;
+      powers.emplace_back(decimalChunksFor(power.size()));
+      limbsToDecimalChunksBasecase(power.data(), power.size(), powers.back().data(), powers.back().size());
+    }
+    else
+      powers.push_back(multiplyDecimalChunks(powers.back().data(), powers.back().size(), powers.back().data(), powers.back().size()));
+    while (powers.back().back() == 0)
+      powers.back().pop_back();
+  }
+
+  vector<uint32_t> low = limbsToDecimalChunks(x, low_length, powers);
+  vector<uint32_t> high = limbsToDecimalChunks(x + low_length, n - low_length, powers);
+  while (!high.empty() && high.back() == 0)
+    high.pop_back();
+  if (high.empty())
+    return low;
+
+  vector<uint32_t> result = multiplyDecimalChunks(high.data(), high.size(), powers[k].data(), powers[k].size());
+  if (result.size() < low.size() + 1)
+    result.resize(low.size() + 1, 0);
+  uint32_t carry = addDecimalChunks(result.data(), result.size(), low.data(), low.size());
+  assert(carry == 0);
+  return result;
+}
+#pragma endregion
+
+#pragma region Parallel
+// Fixed-size pool of worker threads, each with its own task deque. Workers push and pop their own tasks at the back
+// (LIFO, which keeps a divide-and-conquer recursion depth-first and cache-friendly) and steal from the front of the
+// other deques when they run dry. Threads outside the pool submit to a shared deque, which workers also steal from
+class ThreadPool
+{
+  struct Queue
+  {
+    mutex lock;
+    deque<function<void()>> tasks;
+  };
+  vector<unique_ptr<Queue>> queues; // one per worker, then the shared one
+  vector<thread> workers;
+  atomic<bool> stopping{false};
+  atomic<int> queued{0};
+  mutex sleep_lock;
+  condition_variable wake;
+
+  static thread_local ThreadPool *current_pool;
+  static thread_local int current_index;
+
+  int OwnQueueIndex() const
+  {
+    return current_pool == this ? current_index : int(workers.size());
+  }
+
+  void WorkerLoop(int index)
+  {
+    current_pool = this;
+    current_index = index;
+    while (!stopping)
+    {
+      if (TryRunOne())
+        continue;
+      unique_lock<mutex> lock(sleep_lock);
+      wake.wait(lock, [this]() { return stopping || queued > 0; });
+    }
+  }
+
+public:
+  // The calling thread counts towards the thread count, since it runs tasks too while it waits on a TaskGroup
+  explicit ThreadPool(int threads)
+  {
+    int n_workers = max(threads, 1) - 1;
+    for (int i = 0; i <= n_workers; ++i)
+      queues.push_back(make_unique<Queue>());
+    for (int i = 0; i < n_workers; ++i)
+      workers.emplace_back([this, i]() { WorkerLoop(i); });
+  }
+
+  ~ThreadPool()
+  {
+    {
+      lock_guard<mutex> lock(sleep_lock);
+      stopping = true;
+    }
+    wake.notify_all();
+    for (thread &worker : workers)
+      worker.join();
+  }
+
+  int size() const
+  {
+    return workers.size() + 1;
+  }
+
+  void Submit(function<void()> task)
+  {
+    Queue &queue = *queues[OwnQueueIndex()];
+    {
+      lock_guard<mutex> lock(queue.lock);
+      queue.tasks.push_back(move(task));
+    }
+    ++queued;
+    // Taking the sleep lock orders this submission before any worker's next check of the wait condition, so no wakeup is lost
+    {
+      lock_guard<mutex> lock(sleep_lock);
+    }
+    wake.notify_one();
+  }
+
+  // Runs one queued task, preferring the newest task of this thread's own deque, then the oldest task of any other deque
+  bool TryRunOne()
+  {
+    int n = queues.size();
+    int own = OwnQueueIndex();
+    function<void()> task;
+    for (int i = 0; i < n && !task; ++i)
+    {
+      Queue &queue = *queues[(own + i) % n];
+      lock_guard<mutex> lock(queue.lock);
+      if (queue.tasks.empty())
+        continue;
+      if (i == 0)
+      {
+        task = move(queue.tasks.back());
+        queue.tasks.pop_back();
+      }
+      else
+      {
+        task = move(queue.tasks.front());
+        queue.tasks.pop_front();
+      }
+    }
+    if (!task)
+      return false;
+
+    --queued;
+    task();
+    return true;
+  }
+};
+
+thread_local ThreadPool *ThreadPool::current_pool = nullptr;
+thread_local int ThreadPool::current_index = 0;
+
+// Fork-join helper: tasks forked with Run() are all finished once Wait() returns
+class TaskGroup
+{
+  ThreadPool &pool;
+  atomic<int> pending{0};
+
+public:
+  TaskGroup(ThreadPool &_pool) : pool(_pool)
+  { /* nothing */ }
+
+  ~TaskGroup()
+  {
+    Wait();
+  }
+
+  void Run(function<void()> task)
+  {
+    ++pending;
+    pool.Submit([this, task]() {
+      task();
+      --pending;
+    });
+  }
+
+  // Runs queued tasks while waiting rather than blocking, so a task waiting on its children never starves the pool
+  void Wait()
+  {
+    while (pending > 0)
+      if (!pool.TryRunOne())
+        this_thread::yield();
+  }
+};
+
+struct ParallelMultiplyOptions
+{
+  int max_depth = 4;     // number of levels of the recursion that fork tasks; each Karatsuba level forks 3 ways
+  int min_length = 2048; // products of operands shorter than this (in limbs) are always computed sequentially
+};
+
+void parallelMultiplyLimbs(limb_t const *x, int n_x, limb_t const *y, int n_y, limb_t *result, ThreadPool &pool, ParallelMultiplyOptions const &options, int depth);
+
+// result[0, n_x + n_y) = x[0, n_x) * y[0, n_y), running the convolution modulo each of the 3 primes as its own task
+void parallelNttMultiply(limb_t const *x, int n_x, limb_t const *y, int n_y, limb_t *result, ThreadPool &pool)
+{
+  int length = nttLength(n_x, n_y);
+  vector<uint32_t> residues[3], b[3], twiddles[3];
+  {
+    TaskGroup group(pool);
+    for (int p = 0; p < 3; ++p)
+      group.Run([&, p]() {
+        residues[p].resize(length);
+        b[p].resize(length);
+        twiddles[p].resize(length / 2);
+        nttConvolve(x, n_x, y, n_y, NTT_PRIMES[p], residues[p].data(), b[p].data(), twiddles[p].data());
+      });
+    group.Wait();
+  }
+  uint32_t const *const residue_pointers[3] = {residues[0].data(), residues[1].data(), residues[2].data()};
+  nttRecombine(residue_pointers, n_x + n_y, result);
+}
+
+// result[0, 2n) = x[0, n) * y[0, n), forking the three Karatsuba sub-products as tasks
+void parallelKaratsubaMultiply(limb_t const *x, limb_t const *y, int n, limb_t *result, ThreadPool &pool, ParallelMultiplyOptions const &options, int depth)
+{
+  // Same split as karatsubaMultiply(), see there for the details
+  int h = (n + 1) / 2;
+  int l = n - h;
+  limb_t const *a = x + h;
+  limb_t const *b = x;
+  limb_t const *c = y + h;
+  limb_t const *d = y;
+
+  vector<limb_t> sum_ab(h), sum_cd(h), middle(2 * h + 1);
+  limb_t carry_ab = addLimbs(sum_ab.data(), b, h, a, l);
+  limb_t carry_cd = addLimbs(sum_cd.data(), d, h, c, l);
+
+  // ac, bd and the middle product all write to disjoint memory, so they can run concurrently
+  {
+    TaskGroup group(pool);
+    group.Run([&]() { parallelMultiplyLimbs(a, l, c, l, result + 2 * h, pool, options, depth + 1); });
+    group.Run([&]() { parallelMultiplyLimbs(b, h, d, h, result, pool, options, depth + 1); });
+    parallelMultiplyLimbs(sum_ab.data(), h, sum_cd.data(), h, middle.data(), pool, options, depth + 1);
+    group.Wait();
+  }
+
+  middle[2 * h] = carry_ab & carry_cd;
+  if (carry_ab)
+    middle[2 * h] += addLimbs(middle.data() + h, middle.data() + h, h, sum_cd.data(), h);
+  if (carry_cd)
+    middle[2 * h] += addLimbs(middle.data() + h, middle.data() + h, h, sum_ab.data(), h);
+  subtractLimbs(middle.data(), middle.data(), 2 * h + 1, result + 2 * h, 2 * l);
+  subtractLimbs(middle.data(), middle.data(), 2 * h + 1, result, 2 * h);
+  addLimbs(result + h, result + h, n + l, middle.data(), n + 1);
+}
+
+// result[0, n_x + n_y) = x[0, n_x) * y[0, n_y), for any n_x, n_y >= 1. The top max_depth levels of the recursion fork
+// their sub-products onto the pool, and everything below that (or below min_length) runs the sequential multiplyLimbs()
+void parallelMultiplyLimbs(limb_t const *x, int n_x, limb_t const *y, int n_y, limb_t *result, ThreadPool &pool, ParallelMultiplyOptions const &options, int depth = 0)
+{
+  if (n_x < n_y)
+    return parallelMultiplyLimbs(y, n_y, x, n_x, result, pool, options, depth);
+
+  // Leaves run concurrently, so each one gets its own scratch arena
+  if (depth >= options.max_depth || n_y < options.min_length)
+    return multiplyLimbs(x, n_x, y, n_y, result);
+
+  // In the NTT tier, forking Karatsuba levels would only add work, so convolve modulo the 3 primes concurrently instead
+  if (n_x == n_y && n_x >= multiplyThresholds.ntt && nttSupports(n_x, n_y))
+    return parallelNttMultiply(x, n_x, y, n_y, result, pool);
+
+  if (n_x == n_y)
+    return parallelKaratsubaMultiply(x, y, n_x, result, pool, options, depth);
+
+  // Unbalanced operands: split x into a low part as long as y (or half of x, if it is at least twice as long as y) and
+  // the rest, and multiply both parts by y concurrently
+  int split = n_x < 2 * n_y ? n_y : n_x / 2;
+  vector<limb_t> high_product(n_x - split + n_y);
+  {
+    TaskGroup group(pool);
+    group.Run([&]() { parallelMultiplyLimbs(x + split, n_x - split, y, n_y, high_product.data(), pool, options, depth + 1); });
+    parallelMultiplyLimbs(x, split, y, n_y, result, pool, options, depth + 1);
+    group.Wait();
+  }
+  fill(result + split + n_y, result + n_x + n_y, 0);
+  addLimbsAt(result, n_x + n_y, split, high_product.data(), high_product.size());
+}
+
+// Multiplies one fixed operand x[0, n_x) by each of ys[i][0, n_ys[i]) into results[i][0, n_x + n_ys[i]), running the
+// products concurrently. Products in the NTT tier share the forward transforms of x, which are computed once per transform
+// length (and prime) up front, so that each of them costs 2 transforms per prime rather than 3. The other products go
+// through parallelMultiplyLimbs(), whose Karatsuba and slicing splits of x are plain offsets and so cost nothing to redo
+void multiplyBatchLimbs(limb_t const *x, int n_x, vector<limb_t const *> const &ys, vector<int> const &n_ys, vector<limb_t *> const &results,
+                        ThreadPool &pool, ParallelMultiplyOptions const &options)
+{
+  assert(ys.size() == n_ys.size() && ys.size() == results.size());
+  auto sharesTransform = [&](int n_y) {
+    return min(n_x, n_y) >= multiplyThresholds.ntt && nttSupports(n_x, n_y);
+  };
+
+  // transforms[length][p] = the forward transform of x modulo NTT_PRIMES[p], over length points
+  map<int, vector<uint32_t>[3]> transforms;
+  for (int n_y : n_ys)
+    if (sharesTransform(n_y))
+      transforms[nttLength(n_x, n_y)];
+  {
+    TaskGroup group(pool);
+    for (auto &entry : transforms)
+      for (int p = 0; p < 3; ++p)
+        group.Run([&, p]() {
+          int length = entry.first;
+          vector<uint32_t> &transform = entry.second[p];
+          vector<uint32_t> twiddles(length / 2);
+          transform.resize(length);
+          nttForward(x, n_x, length, NTT_PRIMES[p], transform.data(), twiddles.data());
+        });
+    group.Wait();
+  }
+
+  TaskGroup group(pool);
+  for (size_t i = 0; i < ys.size(); ++i)
+    group.Run([&, i]() {
+      limb_t const *y = ys[i];
+      int n_y = n_ys[i];
+      if (!sharesTransform(n_y))
+        return parallelMultiplyLimbs(x, n_x, y, n_y, results[i], pool, options);
+
+      int length = nttLength(n_x, n_y);
+      vector<uint32_t> residues[3], twiddles(length / 2);
+      for (int p = 0; p < 3; ++p)
+      {
+        residues[p].resize(length);
+        nttForward(y, n_y, length, NTT_PRIMES[p], residues[p].data(), twiddles.data());
+        nttPointwiseInverse(residues[p].data(), transforms.at(length)[p].data(), length, NTT_PRIMES[p], twiddles.data());
+      }
+      uint32_t const *const residue_pointers[3] = {residues[0].data(), residues[1].data(), residues[2].data()};
+      nttRecombine(residue_pointers, n_x + n_y, results[i]);
+    });
+  group.Wait();
+}
+#pragma endregion
+
+#pragma region BigInt
+// Arbitrary-precision signed integer, stored as sign and magnitude
+class BigInt
+{
+  vector<limb_t> limbs; // never has leading (most significant) zero limbs, so zero is the empty vector
+  bool negative = false; // never set for zero, so that zero has a single representation
+
+  static int const PARSE_CHUNK_DIGITS = 16;       // digits converted at once by the parse kernel
+  static int const PARSE_BASECASE_DIGITS = 2048; // below this, the quadratic conversion beats divide and conquer
+
+  void Trim()
+  {
+    while (!limbs.empty() && limbs.back() == 0)
+      limbs.pop_back();
+    if (limbs.empty())
+      negative = false;
+  }
+
+  // this = this * m + a
+  void MultiplyAddSmall(uint64_t m, uint64_t a)
+  {
+    unsigned __int128 carry = a;
+    for (limb_t &limb : limbs)
+    {
+      carry += (unsigned __int128)limb * m;
+      limb = limb_t(carry);
+      carry >>= LIMB_BITS;
+    }
+    for (; carry > 0; carry >>= LIMB_BITS)
+      limbs.push_back(limb_t(carry));
+  }
+
+  // Quadratic conversion of n decimal digits, one multiply-accumulate pass over the limbs per 16 digits
+  static BigInt ParseDecimalBasecase(char const *digits, int n)
+  {
+    BigInt value;
+    value.limbs.reserve(n / DECIMAL_CHUNK_DIGITS + 2);
+    int first_chunk = n % PARSE_CHUNK_DIGITS; // the first chunk may be shorter
+    uint64_t scale = 1;
+    for (int i = 0; i < first_chunk; ++i)
+      scale *= 10;
+    value.MultiplyAddSmall(scale, parseDigitsScalar(digits, first_chunk));
+    for (int i = first_chunk; i < n; i += PARSE_CHUNK_DIGITS)
+      value.MultiplyAddSmall(10000000000000000ULL, kernels.parse16Digits(digits + i));
+    value.Trim();
+    return value;
+  }
+
+  // Divide-and-conquer conversion of n decimal digits: the low 16 * 2^k digits (the largest such block shorter than n) and
+  // the rest are converted recursively, then combined as high * 10^(16 * 2^k) + low with the fast multiplication.
+  // powers[k] caches 10^(16 * 2^k), which is built by repeated squaring
+  static BigInt ParseDecimal(char const *digits, int n, vector<BigInt> &powers)
+  {
+    if (n <= PARSE_BASECASE_DIGITS)
+      return ParseDecimalBasecase(digits, n);
+
+    int k = 0;
+    while ((PARSE_CHUNK_DIGITS << (k + 1)) < n)
+      ++k;
+    int low_length = PARSE_CHUNK_DIGITS << k;
+    while (int(powers.size()) <= k)
+      powers.push_back(powers.empty() ? BigInt(10000000000000000ULL) : powers.back() * powers.back());
+
+    return ParseDecimal(digits, n - low_length, powers) * powers[k] + ParseDecimal(digits + n - low_length, low_length, powers);
+  }
+
+public:
+  BigInt() {}
+
+  BigInt(uint64_t value)
+  {
+    for (; value > 0; value >>= LIMB_BITS)
+      limbs.push_back(limb_t(value));
+  }
+
+  // Parses a string of decimal digits, most significant first, with an optional leading minus sign
+  explicit BigInt(string const &decimal)
+  {
+    int start = !decimal.empty() && decimal[0] == '-' ? 1 : 0;
+    assert(all_of(decimal.begin() + start, decimal.end(), [](char c) { return c >= '0' && c <= '9'; }));
+
+    vector<BigInt> powers;
+    *this = ParseDecimal(decimal.data() + start, decimal.length() - start, powers);
+    negative = start == 1;
+    Trim();
+  }
+
+  bool IsZero() const
+  {
+    return limbs.empty();
+  }
+
+  int size() const
+  {
+    return limbs.size();
+  }
+
+  limb_t const *data() const
+  {
+    return limbs.data();
+  }
+
+  string ToString() const
+  {
+    if (IsZero())
+      return "0";
+
+    vector<vector<uint32_t>> powers;
+    vector<uint32_t> chunks = limbsToDecimalChunks(limbs.data(), limbs.size(), powers);
+    while (chunks.back() == 0)
+      chunks.pop_back();
+
+    // Only the most significant chunk is printed without leading zeros; every other one is exactly 9 digits
+    string first = to_string(chunks.back());
+    string s(negative ? "-" : "");
+    s.append(first);
+    s.resize(s.length() + (chunks.size() - 1) * DECIMAL_CHUNK_DIGITS);
+    char *out = &s[s.length() - (chunks.size() - 1) * DECIMAL_CHUNK_DIGITS];
+    for (int i = int(chunks.size()) - 2; i >= 0; --i, out += DECIMAL_CHUNK_DIGITS)
+    {
+      out[0] = '0' + chunks[i] / 100000000;
+      kernels.print8Digits(chunks[i] % 100000000, out + 1);
+    }
+    return s;
+  }
+
+  bool IsNegative() const
+  {
+    return negative;
+  }
+
+  // Compares magnitudes only, ignoring signs
+  friend int compareMagnitudes(BigInt const &x, BigInt const &y)
+  {
+    return compareLimbs(x.data(), x.size(), y.data(), y.size());
+  }
+
+  friend int compare(BigInt const &x, BigInt const &y)
+  {
+    if (x.negative != y.negative)
+      return x.negative ? -1 : 1;
+    int c = compareMagnitudes(x, y);
+    return x.negative ? -c : c;
+  }
+
+  friend bool operator==(BigInt const &x, BigInt const &y)
+  {
+    return x.negative == y.negative && x.limbs == y.limbs;
+  }
+
+  friend BigInt operator-(BigInt const &x)
+  {
+    BigInt negated = x;
+    negated.negative = !x.negative && !x.IsZero();
+    return negated;
+  }
+
+  friend BigInt operator+(BigInt const &x, BigInt const &y)
+  {
+    // Operands of opposite signs reduce to a subtraction of magnitudes
+    if (x.negative != y.negative)
+      return x - (-y);
+
+    if (x.size() < y.size())
+      return y + x;
+
+    BigInt sum;
+    sum.limbs.resize(x.size() + 1);
+    sum.limbs[x.size()] = addLimbs(sum.limbs.data(), x.data(), x.size(), y.data(), y.size());
+    sum.negative = x.negative;
+    sum.Trim();
+    return sum;
+  }
+
+  friend BigInt operator-(BigInt const &x, BigInt const &y)
+  {
+    // Operands of opposite signs reduce to an addition of magnitudes
+    if (x.negative != y.negative)
+      return x + (-y);
+
+    // Always subtract the smaller magnitude from the larger one, so that the limb subtraction never borrows, and fix up the sign instead
+    if (compareMagnitudes(x, y) < 0)
+      return -(y - x);
+
+    BigInt difference;
+    difference.limbs.resize(x.size());
+    limb_t borrow = subtractLimbs(difference.limbs.data(), x.data(), x.size(), y.data(), y.size());
+    assert(borrow == 0);
+    difference.negative = x.negative;
+    difference.Trim();
+    return difference;
+  }
+
+  friend BigInt operator*(BigInt const &x, BigInt const &y)
+  {
+    if (x.IsZero() || y.IsZero())
+      return BigInt();
+
+    BigInt product;
+    product.limbs.resize(x.size() + y.size());
+    multiplyLimbs(x.data(), x.size(), y.data(), y.size(), product.limbs.data());
+    product.negative = x.negative != y.negative;
+    product.Trim();
+    return product;
+  }
+
+  friend BigInt parallelMultiply(BigInt const &x, BigInt const &y, ThreadPool &pool, ParallelMultiplyOptions const &options = ParallelMultiplyOptions())
+  {
+    if (x.IsZero() || y.IsZero())
+      return BigInt();
+
+    BigInt product;
+    product.limbs.resize(x.size() + y.size());
+    parallelMultiplyLimbs(x.data(), x.size(), y.data(), y.size(), product.limbs.data(), pool, options);
+    product.negative = x.negative != y.negative;
+    product.Trim();
+    return product;
+  }
+
+  // products[i] = fixed * others[i], computed concurrently, with the work that depends only on fixed done once
+  friend vector<BigInt> multiplyBatch(BigInt const &fixed, vector<BigInt> const &others, ThreadPool &pool,
+                                      ParallelMultiplyOptions const &options = ParallelMultiplyOptions())
+  {
+    vector<BigInt> products(others.size());
+    vector<limb_t const *> ys;
+    vector<int> n_ys;
+    vector<limb_t *> results;
+    for (size_t i = 0; i < others.size(); ++i)
+    {
+      if (fixed.IsZero() || others[i].IsZero())
+        continue;
+      products[i].limbs.resize(fixed.size() + others[i].size());
+      products[i].negative = fixed.negative != others[i].negative;
+      ys.push_back(others[i].data());
+      n_ys.push_back(others[i].size());
+      results.push_back(products[i].limbs.data());
+    }
+    multiplyBatchLimbs(fixed.data(), fixed.size(), ys, n_ys, results, pool, options);
+    for (BigInt &product : products)
+      product.Trim();
+    return products;
+  }
+};
+#pragma endregion
+
+// The decimal string API is kept as a thin wrapper over BigInt
+string add(string const &a, string const &b)
 {
-  return c - '0';
+  return (BigInt(a) + BigInt(b)).ToString();
 }
 
-char itoc(int i)
+string subtract(string const &a, string const &b)
 {
-  return '0' + i;
+  return (BigInt(a) - BigInt(b)).ToString();
 }
 
-string add(string const &a, string const &b)
+string multiply(string const &x, string const &y)
 {
-  int length_a = a.length();
-  int length_b = b.length();
-  if (length_b > length_a)
-    return add(b, a);
+  return (BigInt(x) * BigInt(y)).ToString();
+}
+
+#pragma region Streaming
+// Read-only memory map of a whole file
+class MappedFile
+{
+  int descriptor = -1;
+  char *bytes = nullptr;
+  size_t length = 0;
 
-  vector<char> result;
-  int carry = 0;
-  for (int i_a = length_a - 1, i_b = length_b - 1; i_a >= 0; --i_a, --i_b)
+public:
+  MappedFile(string const &path)
   {
-    int v_a = ctoi(a[i_a]);
-    int v = carry + v_a;
-    if (i_b >= 0)
-    {
-      int v_b = ctoi(b[i_b]);
-      v += v_b;
-    }
+    descriptor = open(path.c_str(), O_RDONLY);
+    struct stat status;
+    if (descriptor < 0 || fstat(descriptor, &status) != 0 || status.st_size == 0)
+      return;
+    void *mapping = mmap(nullptr, status.st_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    if (mapping == MAP_FAILED)
+      return;
+    bytes = static_cast<char *>(mapping);
+    length = status.st_size;
+  }
+
+  MappedFile(MappedFile const &) = delete;
+  MappedFile &operator=(MappedFile const &) = delete;
+
+  ~MappedFile()
+  {
+    if (bytes != nullptr)
+      munmap(bytes, length);
+    if (descriptor >= 0)
+      close(descriptor);
+  }
+
+  bool IsMapped() const
+  {
+    return bytes != nullptr;
+  }
+
+  char const *data() const
+  {
+    return bytes;
+  }
 
-    carry = v / 10;
-    int digit = v - carry * 10;
-    result.push_back(itoc(digit));
+  size_t size() const
+  {
+    return length;
+  }
+
+  // Drops the pages of [begin, end) from the resident set of the process. They stay in the page cache, and are read back
+  // in if they are touched again
+  void Release(char const *begin, char const *end) const
+  {
+    size_t page = sysconf(_SC_PAGESIZE);
+    size_t first = size_t(begin - bytes) / page * page;
+    if (size_t(end - bytes) > first)
+      madvise(bytes + first, size_t(end - bytes) - first, MADV_DONTNEED);
   }
-  if (carry > 0)
+};
+
+// A decimal number in a mapped file: an optional '-', the digits, then optional whitespace. digits[0, n) has no leading
+// zeros, so zero has n = 0
+struct DecimalFileOperand
+{
+  char const *digits = nullptr;
+  int64_t n = 0;
+  bool negative = false;
+};
+
+// Options for multiplyFiles()
+struct StreamMultiplyOptions
+{
+  int block_chunks = 1 << 20; // operands are multiplied in blocks of this many base 10^9 chunks (9 decimal digits each)
+  int validate_bytes = 1 << 24; // the input is validated this many bytes at a time
+};
+
+// Validates the decimal number in file, one block at a time so that it is never resident as a whole
+bool readDecimalFileOperand(MappedFile const &file, DecimalFileOperand &operand, StreamMultiplyOptions const &options)
+{
+  char const *begin = file.data(), *end = file.data() + file.size();
+  while (end > begin && isspace(static_cast<unsigned char>(end[-1])))
+    --end;
+  operand.negative = begin < end && *begin == '-';
+  begin += operand.negative;
+  if (begin == end)
+    return false;
+
+  for (char const *block = begin; block < end; block += min<int64_t>(end - block, options.validate_bytes))
   {
-    result.push_back(itoc(carry));
+    char const *block_end = block + min<int64_t>(end - block, options.validate_bytes);
+    if (!all_of(block, block_end, [](char c) { return c >= '0' && c <= '9'; }))
+      return false;
+    file.Release(block, block_end);
   }
 
-  stringstream ss;
-  for (auto it = result.rbegin(); it != result.rend(); ++it)
-    ss << *it;
-  return ss.str();
+  while (begin < end && *begin == '0')
+    ++begin;
+  operand.digits = begin;
+  operand.n = end - begin;
+  operand.negative = operand.negative && operand.n > 0;
+  return true;
 }
 
-void padZero(string &s, int const n)
+// Number of base 10^9 chunks in operand
+int64_t decimalChunkCount(DecimalFileOperand const &operand)
 {
-  if (n <= 0)
-    return;
+  return (operand.n + DECIMAL_CHUNK_DIGITS - 1) / DECIMAL_CHUNK_DIGITS;
+}
 
-  for (int i = 0; i < n; ++i)
-    s.push_back('0');
+// chunks[0, count) = chunks [first, first + count) of operand in base 10^9, least significant first
+void readDecimalChunks(MappedFile const &file, DecimalFileOperand const &operand, int64_t first, int count, uint32_t *chunks)
+{
+  int64_t end = operand.n - first * DECIMAL_CHUNK_DIGITS;
+  for (int c = 0; c < count; ++c, end -= DECIMAL_CHUNK_DIGITS)
+  {
+    int64_t begin = max<int64_t>(0, end - DECIMAL_CHUNK_DIGITS);
+    chunks[c] = uint32_t(parseDigitsScalar(operand.digits + begin, end - begin));
+  }
+  file.Release(operand.digits + max<int64_t>(0, end), operand.digits + operand.n - first * DECIMAL_CHUNK_DIGITS);
 }
 
-void padZeroPrefix(string &s, int const n)
+// Writes all of buffer[0, n) to the file at offset
+bool writeAll(int descriptor, char const *buffer, size_t n, off_t offset)
 {
-  if (n <= 0)
-    return;
+  while (n > 0)
+  {
+    ssize_t written = pwrite(descriptor, buffer, n, offset);
+    if (written <= 0)
+      return false;
+    buffer += written;
+    n -= written;
+    offset += written;
+  }
+  return true;
+}
 
-  for (int i = 0; i < n; ++i)
-    s.insert(s.begin(), '0');
+// Writes chunks [first, first + count) of a number of n_digits digits (possibly with one leading zero) to the file, whose
+// digits start at offset start. Digits that would fall before the start are zero and are dropped
+bool writeDecimalChunks(int descriptor, off_t start, int64_t n_digits, int64_t first, int count, uint32_t const *chunks, string &buffer)
+{
+  int64_t end = max<int64_t>(0, n_digits - first * DECIMAL_CHUNK_DIGITS);
+  int64_t begin = max<int64_t>(0, end - int64_t(count) * DECIMAL_CHUNK_DIGITS);
+  buffer.resize(int64_t(count) * DECIMAL_CHUNK_DIGITS);
+  char *out = &buffer[buffer.length()];
+  for (int c = 0; c < count; ++c)
+  {
+    out -= DECIMAL_CHUNK_DIGITS;
+    out[0] = '0' + chunks[c] / 100000000;
+    kernels.print8Digits(chunks[c] % 100000000, out + 1);
+  }
+  assert(all_of(buffer.data(), buffer.data() + buffer.length() - (end - begin), [](char c) { return c == '0'; }));
+  return writeAll(descriptor, buffer.data() + buffer.length() - (end - begin), end - begin, start + begin);
+}
+
+// Multiplies the decimal numbers in the files at x_path and y_path into a new file at output_path, in working memory
+// bounded by the block size rather than by the operands. Both inputs are memory-mapped and converted to base 10^9 a block
+// at a time, and the product is accumulated one block of chunks ("column") at a time, least significant first: column k
+// is the sum of the products of blocks i of x and j of y with i + j = k (each with the fast chunk multiplication), plus
+// the carry from column k - 1. A finished column is printed straight to its place in the output, since the number of
+// digits of the product is known up to a possible leading zero, which is removed at the end. For operands of n chunks
+// this does (n / block_chunks)^2 block products, trading time for memory. Returns false (with a message on cerr) on error
+bool multiplyFiles(string const &x_path, string const &y_path, string const &output_path, StreamMultiplyOptions const &options = StreamMultiplyOptions())
+{
+  MappedFile x_file(x_path), y_file(y_path);
+  DecimalFileOperand x, y;
+  auto read = [&](MappedFile const &file, DecimalFileOperand &operand, string const &path) {
+    bool success = file.IsMapped() && readDecimalFileOperand(file, operand, options);
+    if (!success)
+      cerr << "Could not read a decimal number from " << path << endl;
+    return success;
+  };
+  if (!read(x_file, x, x_path) || !read(y_file, y, y_path))
+    return false;
+
+  int descriptor = open(output_path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (descriptor < 0)
+  {
+    cerr << "Could not create " << output_path << endl;
+    return false;
+  }
+  unique_ptr<int, void (*)(int *)> closer(&descriptor, [](int *d) { close(*d); });
+  if (x.n == 0 || y.n == 0)
+    return writeAll(descriptor, "0\n", 2, 0);
+
+  bool negative = x.negative != y.negative;
+  int64_t n_digits = x.n + y.n; // the product has this many digits, or one fewer
+  int64_t n_x = decimalChunkCount(x), n_y = decimalChunkCount(y), n_product = n_x + n_y;
+  int block = options.block_chunks;
+  int64_t x_blocks = (n_x + block - 1) / block, y_blocks = (n_y + block - 1) / block;
+
+  // column holds the column being summed in its low block_chunks chunks and the carry into the next one above them
+  vector<uint32_t> column(2 * size_t(block) + 1), x_block(block), y_block(block);
+  string buffer;
+  for (int64_t k = 0; k * block < n_product; ++k)
+  {
+    for (int64_t i = max<int64_t>(0, k - y_blocks + 1); i <= min(k, x_blocks - 1); ++i)
+    {
+      int64_t j = k - i;
+      int x_length = min<int64_t>(block, n_x - i * block), y_length = min<int64_t>(block, n_y - j * block);
+      readDecimalChunks(x_file, x, i * block, x_length, x_block.data());
+      readDecimalChunks(y_file, y, j * block, y_length, y_block.data());
+      vector<uint32_t> product = multiplyDecimalChunks(x_block.data(), x_length, y_block.data(), y_length);
+      uint32_t carry = addDecimalChunks(column.data(), column.size(), product.data(), product.size());
+      assert(carry == 0);
+    }
+
+    int count = min<int64_t>(block, n_product - k * block);
+    if (!writeDecimalChunks(descriptor, negative, n_digits, k * block, count, column.data(), buffer))
+    {
+      cerr << "Could not write to " << output_path << endl;
+      return false;
+    }
+    copy(column.begin() + block, column.end(), column.begin());
+    fill(column.begin() + block + 1, column.end(), 0);
+  }
+
+  // Drop the leading zero, if there is one, by moving the digits after it down a block at a time
+  char leading;
+  if (pread(descriptor, &leading, 1, negative) != 1)
+    return false;
+  if (leading == '0')
+  {
+    buffer.resize(size_t(block) * DECIMAL_CHUNK_DIGITS);
+    for (int64_t moved = 1; moved < n_digits; moved += buffer.length())
+    {
+      size_t length = min<int64_t>(buffer.length(), n_digits - moved);
+      if (pread(descriptor, &buffer[0], length, negative + moved) != ssize_t(length) || !writeAll(descriptor, buffer.data(), length, negative + moved - 1))
+        return false;
+    }
+    --n_digits;
+  }
+  return (!negative || writeAll(descriptor, "-", 1, 0)) && writeAll(descriptor, "\n", 1, negative + n_digits) &&
+         ftruncate(descriptor, negative + n_digits + 1) == 0;
+}
+
+// Peak resident set size of the process so far, in kilobytes
+long peakResidentKilobytes()
+{
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss;
 }
+#pragma endregion
 
-string multiplyNumbersOfSameLengthPow2(string const &x, string const &y)
+#pragma region Tuning
+vector<limb_t> randomLimbs(int n, mt19937 &rng)
 {
-  int n = x.length();
+  vector<limb_t> v(n);
+  for (limb_t &limb : v)
+    limb = rng();
+  return v;
+}
+
+// Average wall time in seconds of one call to f, repeated until enough time has passed for the clock to be accurate
+template <typename F>
+double timeCall(F const &f)
+{
+  auto start = chrono::steady_clock::now();
+  int repetitions = 0;
+  double elapsed;
+  do
+  {
+    f();
+    ++repetitions;
+    elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+  } while (elapsed < 0.02);
+  return elapsed / repetitions;
+}
+
+// Finds the crossover points between the multiplication algorithms by timing them against each other at increasing sizes
+// Thresholds are found bottom-up, each algorithm racing one level of itself (over the tiers below it) against the tiers below it
+MultiplyThresholds tuneMultiplyThresholds()
+{
+  MultiplyThresholds &t = multiplyThresholds;
+  t.karatsuba = t.toom3 = t.ntt = INT_MAX;
+  mt19937 rng(12345);
+
+  auto crossover = [&](int from, int to, void (*above)(limb_t const *, limb_t const *, int, limb_t *, ScratchArena &), size_t (*aboveScratchSize)(int)) {
+    for (int n = from; n < to; n += max(1, n / 8))
+    {
+      vector<limb_t> x = randomLimbs(n, rng), y = randomLimbs(n, rng), result(2 * n);
+      ScratchArena arena(max(sameLengthScratchSize(n), aboveScratchSize(n)));
+      double time_below = timeCall([&]() { multiplyNumbersOfSameLength(x.data(), y.data(), n, result.data(), arena); });
+      double time_above = timeCall([&]() { above(x.data(), y.data(), n, result.data(), arena); });
+      if (time_above < time_below)
+        return n;
+    }
+    return to;
+  };
 
-  // Base case
-  if (n == 1)
+  t.karatsuba = crossover(2, 1024, karatsubaMultiply, karatsubaScratchSize);
+  t.toom3 = crossover(max(t.karatsuba, 5), 8192, toom3Multiply, toom3ScratchSize);
+  t.ntt = crossover(
+      t.toom3, 1 << 17,
+      [](limb_t const *x, limb_t const *y, int n, limb_t *result, ScratchArena &arena) { nttMultiply(x, n, y, n, result, arena); },
+      [](int n) { return nttScratchSize(n, n); });
+  return t;
+}
+// Times parallelMultiplyLimbs() with 1 to max_threads threads against the sequential multiplyLimbs(), for a few operand sizes
+void reportParallelSpeedup(int max_threads)
+{
+  mt19937 rng(12345);
+  cout << "limbs,threads,sequential_seconds,parallel_seconds,speedup" << endl;
+  for (int n : {8192, 32768, 131072})
   {
-    int product = ctoi(x[0]) * ctoi(y[0]);
-    stringstream ss;
-    ss << product;
-    return ss.str();
+    vector<limb_t> x = randomLimbs(n, rng), y = randomLimbs(n, rng), result(2 * n);
+    double sequential = timeCall([&]() { multiplyLimbs(x.data(), n, y.data(), n, result.data()); });
+    for (int threads = 1; threads <= max_threads; threads *= 2)
+    {
+      ThreadPool pool(threads);
+      double parallel = timeCall([&]() { parallelMultiplyLimbs(x.data(), n, y.data(), n, result.data(), pool, ParallelMultiplyOptions()); });
+      cout << n << "," << threads << "," << sequential << "," << parallel << "," << sequential / parallel << endl;
+    }
   }
+}
+#pragma endregion
 
-  // Else, divide and conquer
-  int n2 = n / 2;
-  string a = x.substr(0, n2);
-  string b = x.substr(n2, n2);
-  string c = y.substr(0, n2);
-  string d = y.substr(n2, n2);
+#pragma region Benchmark
+// Every heap allocation in the program goes through these replacements of the global operator new, so the benchmark can
+// count the allocations made by a call. They are kept out of line, or GCC would see malloc() and free() paired with new
+// and delete and warn about mismatched allocation functions
+atomic<long long> allocationCount{0};
 
-  string ac = multiplyNumbersOfSameLengthPow2(a, c);
-  string bd = multiplyNumbersOfSameLengthPow2(b, d);
-  // Normally, you'd do ad + bc = (a+b)(c+d) - ac - bd, but I don't want to bother with implementing subtraction for my string-based big-int representation, so I'll just stick to the 4 multiplication version
-  string ad = multiplyNumbersOfSameLengthPow2(a, d);
-  string bc = multiplyNumbersOfSameLengthPow2(b, c);
-  string ad_plus_bc = add(ad, bc);
+__attribute__((noinline)) void *operator new(size_t size)
+{
+  ++allocationCount;
+  if (void *p = malloc(size == 0 ? 1 : size))
+    return p;
+  throw bad_alloc();
+}
 
-  // Pad
-  padZero(ac, n);
-  padZero(ad_plus_bc, n2);
+__attribute__((noinline)) void operator delete(void *p) noexcept
+{
+  free(p);
+}
 
-  // Add
-  string done = add(ac, add(ad_plus_bc, bd));
-  return done;
+__attribute__((noinline)) void operator delete(void *p, size_t) noexcept
+{
+  free(p);
 }
 
-string multiply(string const &x, string const &y)
+// One timed call of a multiplication tier
+struct BenchmarkResult
+{
+  string tier;
+  int digits;
+  int limbs;
+  double seconds;
+  long long allocations;
+};
+
+// Least-squares slope of log(seconds) against log(digits) over the results of tier with at least min_digits digits (or over
+// all of them, if fewer than two are that large), which is the exponent of the running time in the number of digits
+double fitExponent(vector<BenchmarkResult> const &results, string const &tier, int min_digits)
+{
+  vector<pair<double, double>> points;
+  for (int pass = 0; pass < 2 && points.size() < 2; ++pass, min_digits = 0)
+  {
+    points.clear();
+    for (BenchmarkResult const &result : results)
+      if (result.tier == tier && result.digits >= min_digits)
+        points.push_back({log(double(result.digits)), log(result.seconds)});
+  }
+  if (points.size() < 2)
+    return 0;
+
+  double mean_x = 0, mean_y = 0;
+  for (auto const &point : points)
+  {
+    mean_x += point.first / points.size();
+    mean_y += point.second / points.size();
+  }
+  double covariance = 0, variance = 0;
+  for (auto const &point : points)
+  {
+    covariance += (point.first - mean_x) * (point.second - mean_y);
+    variance += (point.first - mean_x) * (point.first - mean_x);
+  }
+  return covariance / variance;
+}
+
+// Times multiply() on decimal strings and each multiplication tier on limbs, for random operands of 10 to max_digits digits,
+// and prints the time per call, the time per digit, the allocations per call and the fitted exponent of each tier as CSV or
+// JSON. A tier is dropped from the larger sizes once one call takes longer than max_seconds
+void runBenchmark(bool json, int max_digits, double max_seconds)
 {
-  int length_x = x.length();
-  int length_y = y.length();
+  MultiplyThresholds const tuned = multiplyThresholds;
+  auto thresholds = [&](int karatsuba, int toom3, int ntt) {
+    return [=]() { multiplyThresholds = {karatsuba, toom3, ntt}; };
+  };
+  struct Tier
+  {
+    string name;
+    function<void()> configure; // sets the thresholds, so that no tier above this one is used
+    bool string_operands;
+  };
+  vector<Tier> tiers = {
+      {"multiply", thresholds(tuned.karatsuba, tuned.toom3, tuned.ntt), true},
+      {"schoolbook", thresholds(INT_MAX, INT_MAX, INT_MAX), false},
+      {"karatsuba", thresholds(tuned.karatsuba, INT_MAX, INT_MAX), false},
+      {"toom3", thresholds(tuned.karatsuba, tuned.toom3, INT_MAX), false},
+      {"ntt", thresholds(tuned.karatsuba, tuned.toom3, 1), false},
+  };
+
+  mt19937 rng(12345);
+  vector<BenchmarkResult> results;
+  vector<bool> dropped(tiers.size(), false);
+  for (int digits = 10; digits <= max_digits; digits = digits % 3 == 0 ? digits / 3 * 10 : digits * 3)
+  {
+    string x_digits(digits, '0'), y_digits(digits, '0');
+    for (int i = 0; i < digits; ++i)
+    {
+      x_digits[i] += i == 0 ? 1 + rng() % 9 : rng() % 10;
+      y_digits[i] += i == 0 ? 1 + rng() % 9 : rng() % 10;
+    }
+    BigInt x(x_digits), y(y_digits);
+    int n = max(x.size(), y.size());
+    vector<limb_t> x_limbs(x.data(), x.data() + x.size()), y_limbs(y.data(), y.data() + y.size()), result(2 * n);
+    x_limbs.resize(n);
+    y_limbs.resize(n);
 
-  if (length_x < length_y)
-    return multiply(y, x);
+    for (size_t t = 0; t < tiers.size(); ++t)
+    {
+      if (dropped[t] || (tiers[t].name == "ntt" && !nttSupports(n, n)))
+        continue;
+      tiers[t].configure();
+      function<void()> call = [&]() { multiply(x_digits, y_digits); };
+      if (!tiers[t].string_operands)
+        call = [&]() { multiplyLimbs(x_limbs.data(), n, y_limbs.data(), n, result.data()); };
 
-  // Pad up to the next power of 2
-  string x_padded = x;
-  int zerosToPadForPow2 = int(pow(2, ceil(log2(length_x)))) - length_x;
-  padZeroPrefix(x_padded, zerosToPadForPow2);
-  string y_padded = y;
-  padZeroPrefix(y_padded, x_padded.length() - length_y);
+      // The first call counts the allocations, and is the measurement too if it is long enough for the clock to be accurate
+      long long allocations_before = allocationCount;
+      auto start = chrono::steady_clock::now();
+      call();
+      double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+      long long allocations = allocationCount - allocations_before;
+      if (seconds < 0.02)
+        seconds = timeCall(call);
+      results.push_back({tiers[t].name, digits, n, seconds, allocations});
+      dropped[t] = seconds > max_seconds;
+    }
+  }
+  multiplyThresholds = tuned;
 
-  // Compute the result
-  string result = multiplyNumbersOfSameLengthPow2(x_padded, y_padded);
+  map<string, double> exponents;
+  for (Tier const &tier : tiers)
+    exponents[tier.name] = fitExponent(results, tier.name, 1000);
 
-  // Remove leading zeros
-  int unpaddedStart = 0;
-  for (int i = 0; i < result.length(); ++i)
+  if (!json)
+    cout << "tier,digits,limbs,seconds,ns_per_digit,allocations,fitted_exponent" << endl;
+  else
+    cout << "{\"results\": [" << endl;
+  for (size_t i = 0; i < results.size(); ++i)
+  {
+    BenchmarkResult const &r = results[i];
+    double ns_per_digit = r.seconds * 1e9 / r.digits;
+    if (!json)
+      cout << r.tier << "," << r.digits << "," << r.limbs << "," << r.seconds << "," << ns_per_digit << "," << r.allocations << "," << exponents[r.tier] << endl;
+    else
+      cout << "  {\"tier\": \"" << r.tier << "\", \"digits\": " << r.digits << ", \"limbs\": " << r.limbs << ", \"seconds\": " << r.seconds
+           << ", \"ns_per_digit\": " << ns_per_digit << ", \"allocations\": " << r.allocations << "}" << (i + 1 < results.size() ? "," : "") << endl;
+  }
+  if (json)
   {
-    unpaddedStart = i;
-    if (result[i] != '0')
-      break;
+    cout << "], \"fitted_exponents\": {";
+    for (size_t t = 0; t < tiers.size(); ++t)
+      cout << (t == 0 ? "" : ", ") << "\"" << tiers[t].name << "\": " << exponents[tiers[t].name];
+    cout << "}}" << endl;
   }
-  return result.substr(unpaddedStart, string::npos);
 }
+#pragma endregion
 
-int main()
+int main(int argc, char *argv[])
 {
+  if (argc > 1 && string(argv[1]) == "--tune")
+  {
+    MultiplyThresholds t = tuneMultiplyThresholds();
+    cout << "Thresholds (limbs): Karatsuba = " << t.karatsuba << ", Toom-3 = " << t.toom3 << ", NTT = " << t.ntt << endl;
+    return 0;
+  }
+  if (argc > 1 && string(argv[1]) == "--parallel")
+  {
+    int max_threads = argc > 2 ? stoi(argv[2]) : max(1, int(thread::hardware_concurrency()));
+    reportParallelSpeedup(max_threads);
+    return 0;
+  }
+  if (argc > 1 && string(argv[1]) == "--benchmark")
+  {
+    bool json = argc > 2 && string(argv[2]) == "json";
+    int max_digits = argc > 3 ? stoi(argv[3]) : 10000000;
+    double max_seconds = argc > 4 ? stod(argv[4]) : 2;
+    runBenchmark(json, max_digits, max_seconds);
+    return 0;
+  }
+  if (argc > 4 && string(argv[1]) == "--multiply-files")
+  {
+    StreamMultiplyOptions options;
+    if (argc > 5)
+      options.block_chunks = stoi(argv[5]);
+    auto start = chrono::steady_clock::now();
+    bool success = multiplyFiles(argv[2], argv[3], argv[4], options);
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << (success ? "Product written to " : "Failed to write ") << argv[4] << " in " << seconds << " s, peak RSS "
+         << peakResidentKilobytes() / 1024.0 << " MB" << endl;
+    return success ? 0 : 1;
+  }
+
   map<pair<string, string>, string> testCases = {
       {{"2", "2"}, "4"},
       {{"3", "4"}, "12"},
@@ -153,6 +2056,15 @@ int main()
       {{"1950293", "529503"}, "1032685994379"},
       {{"12345", "87654"}, "1082088630"},
       {{"12345678", "87654"}, "1082148059412"},
+      {{"0", "87654"}, "0"},
+      {{"4294967296", "4294967296"}, "18446744073709551616"},
+      {{"18446744073709551615", "18446744073709551615"}, "340282366920938463426481119284349108225"},
+      {{"1000000000000000000000000000000", "999999999999999999999999999999"}, "999999999999999999999999999999000000000000000000000000000000"},
+      {{"-3", "4"}, "-12"},
+      {{"-78", "-76"}, "5928"},
+      {{"-1950293", "0"}, "0"},
+      {{"340282366920938463463374607431768211455", "4294967295"}, "1461501636990620551282746369252908412219869364225"},
+      {{"4294967295", "1461501637330902918203684832716283019655932542975"}, "6277101733925179126504886505003981583386072424803807002625"},
   };
 
   for (auto const &testCase : testCases)
@@ -168,10 +2080,238 @@ int main()
     cout << endl;
   }
 
+  // Addition and subtraction, checked against each other: (a + b) - b == a
+  map<pair<string, string>, string> additionTestCases = {
+      {{"0", "0"}, "0"},
+      {{"999999999", "1"}, "1000000000"},
+      {{"4294967295", "1"}, "4294967296"},
+      {{"18446744073709551615", "1"}, "18446744073709551616"},
+      {{"123456789012345678901234567890", "987654321098765432109876543210"}, "1111111110111111111011111111100"},
+      {{"5", "-12"}, "-7"},
+      {{"-5", "-12"}, "-17"},
+      {{"-4294967296", "4294967296"}, "0"},
+      {{"-18446744073709551616", "1"}, "-18446744073709551615"},
+  };
+
+  for (auto const &testCase : additionTestCases)
+  {
+    string const &a = testCase.first.first;
+    string const &b = testCase.first.second;
+    string result = add(a, b);
+    string const &expected = testCase.second;
+    bool success = result == expected && subtract(result, b) == a;
+    cout << a << " + " << b << " = " << result << (success ? "" : " (FAIL! ");
+    if (!success)
+      cout << "Expected " << expected << ")";
+    cout << endl;
+  }
+
+  // Every multiplication tier, checked against schoolbook multiplication on random operands
+  {
+    mt19937 rng(42);
+    vector<pair<int, int>> sizes = {{1, 1}, {2, 2}, {3, 3}, {5, 5}, {7, 7}, {16, 16}, {33, 33}, {100, 100}, {257, 257}, {1000, 1000}, {3001, 3001}, {1000, 7}, {5000, 300}, {4000, 1999}};
+    for (auto const &size : sizes)
+    {
+      int n_x = size.first, n_y = size.second;
+      vector<limb_t> x = randomLimbs(n_x, rng), y = randomLimbs(n_y, rng);
+      vector<limb_t> expected(n_x + n_y), result(n_x + n_y);
+      schoolbookMultiply(x.data(), n_x, y.data(), n_y, expected.data());
+
+      vector<pair<string, bool>> tiers;
+      if (n_x == n_y && n_x >= 2)
+      {
+        ScratchArena arena(karatsubaScratchSize(n_x));
+        karatsubaMultiply(x.data(), y.data(), n_x, result.data(), arena);
+        tiers.push_back({"Karatsuba", result == expected});
+      }
+      if (n_x == n_y && n_x >= 5)
+      {
+        ScratchArena arena(toom3ScratchSize(n_x));
+        toom3Multiply(x.data(), y.data(), n_x, result.data(), arena);
+        tiers.push_back({"Toom-3", result == expected});
+      }
+      {
+        ScratchArena arena(nttScratchSize(n_x, n_y));
+        nttMultiply(x.data(), n_x, y.data(), n_y, result.data(), arena);
+      }
+      tiers.push_back({"NTT", result == expected});
+      multiplyLimbs(x.data(), n_x, y.data(), n_y, result.data());
+      tiers.push_back({"Dispatched", result == expected});
+
+      cout << n_x << " x " << n_y << " limbs:";
+      for (auto const &tier : tiers)
+        cout << " " << tier.first << (tier.second ? "" : " (FAIL!)");
+      cout << endl;
+    }
+  }
+
+  // The SIMD kernels, checked against the scalar ones on inputs with long carry and borrow chains
+  {
+    mt19937 rng(3);
+    bool success = true;
+    for (int n : {1, 7, 8, 9, 64, 333})
+      for (int pattern = 0; pattern < 4; ++pattern)
+      {
+        vector<limb_t> a = randomLimbs(n, rng), b = randomLimbs(n, rng);
+        for (int i = 0; i < n; ++i)
+        {
+          if (pattern == 1 || (pattern == 3 && rng() % 2))
+            a[i] = ~limb_t(0); // a + 1 ripples through every lane
+          if (pattern == 2 || (pattern == 3 && rng() % 2))
+            b[i] = 0; // a - b borrows through equal lanes...
+        }
+        if (pattern == 2)
+        {
+          a.assign(n, 0); // ...all the way up
+          b[0] = 1;
+        }
+        for (int n_b : {n, n / 2})
+        {
+          vector<limb_t> expected(n), result(n);
+          success &= kernels.add(result.data(), a.data(), n, b.data(), n_b) == SCALAR_KERNELS.add(expected.data(), a.data(), n, b.data(), n_b);
+          success &= result == expected;
+          success &= kernels.subtract(result.data(), a.data(), n, b.data(), n_b) == SCALAR_KERNELS.subtract(expected.data(), a.data(), n, b.data(), n_b);
+          success &= result == expected;
+        }
+      }
+    for (int i = 0; i < 1000; ++i)
+    {
+      string digits = to_string(rng() % 100000000) + to_string(rng() % 100000000);
+      digits = string(16 - digits.length(), '0') + digits;
+      success &= kernels.parse16Digits(digits.data()) == SCALAR_KERNELS.parse16Digits(digits.data());
+      char expected[8], result[8];
+      uint32_t value = i < 10 ? i : rng() % 100000000;
+      kernels.print8Digits(value, result);
+      SCALAR_KERNELS.print8Digits(value, expected);
+      success &= equal(result, result + 8, expected);
+    }
+    cout << "Kernels (" << kernels.name << ")" << (success ? "" : " (FAIL!)") << endl;
+  }
+
+  // Decimal conversion round trips, long enough to take the divide-and-conquer parse
+  {
+    mt19937 rng(5);
+    for (int n : {1, 15, 16, 17, 2048, 2049, 5000, 100000})
+    {
+      string digits(n, '0');
+      for (char &digit : digits)
+        digit = '0' + rng() % 10;
+      digits[0] = '1' + rng() % 9;
+      bool success = BigInt(digits).ToString() == digits && (-BigInt(digits)).ToString() == "-" + digits;
+      cout << n << " digits: Parse and print" << (success ? "" : " (FAIL!)") << endl;
+    }
+  }
+
+  // The parallel multiplication, checked against the sequential one, with thresholds low enough to fork on small operands
+  {
+    mt19937 rng(7);
+    ThreadPool pool(4);
+    ParallelMultiplyOptions options;
+    options.min_length = 16;
+    vector<pair<int, int>> sizes = {{100, 100}, {1001, 1001}, {777, 31}, {5000, 2100}, {40000, 40000}};
+    for (auto const &size : sizes)
+    {
+      int n_x = size.first, n_y = size.second;
+      vector<limb_t> x = randomLimbs(n_x, rng), y = randomLimbs(n_y, rng);
+      vector<limb_t> expected(n_x + n_y), result(n_x + n_y);
+      multiplyLimbs(x.data(), n_x, y.data(), n_y, expected.data());
+      parallelMultiplyLimbs(x.data(), n_x, y.data(), n_y, result.data(), pool, options);
+      cout << n_x << " x " << n_y << " limbs: Parallel" << (result == expected ? "" : " (FAIL!)") << endl;
+    }
+  }
+
+  // The batch multiplication, checked against one multiplication at a time, with operands in and out of the NTT tier
+  // (and products of two transform lengths) sharing the fixed operand
+  {
+    mt19937 rng(8);
+    ThreadPool pool(4);
+    int n_x = 40000;
+    vector<limb_t> x = randomLimbs(n_x, rng);
+    vector<vector<limb_t>> ys, results;
+    for (int n_y : {40000, 33000, 100000, 1000, 1, 40000})
+    {
+      ys.push_back(randomLimbs(n_y, rng));
+      results.emplace_back(n_x + n_y);
+    }
+    vector<limb_t const *> y_pointers;
+    vector<int> n_ys;
+    vector<limb_t *> result_pointers;
+    for (size_t i = 0; i < ys.size(); ++i)
+    {
+      y_pointers.push_back(ys[i].data());
+      n_ys.push_back(ys[i].size());
+      result_pointers.push_back(results[i].data());
+    }
+    multiplyBatchLimbs(x.data(), n_x, y_pointers, n_ys, result_pointers, pool, ParallelMultiplyOptions());
+    for (size_t i = 0; i < ys.size(); ++i)
+    {
+      vector<limb_t> expected(n_x + n_ys[i]);
+      multiplyLimbs(x.data(), n_x, ys[i].data(), n_ys[i], expected.data());
+      cout << n_x << " x " << n_ys[i] << " limbs: Batch" << (results[i] == expected ? "" : " (FAIL!)") << endl;
+    }
+
+    BigInt fixed("-123456789012345678901234567890");
+    vector<BigInt> others = {BigInt(0), BigInt(7), BigInt("-99999999999999999999"), fixed};
+    vector<BigInt> products = multiplyBatch(fixed, others, pool);
+    bool success = products.size() == others.size();
+    for (size_t i = 0; success && i < others.size(); ++i)
+      success = products[i] == fixed * others[i];
+    cout << "Signed BigInt: Batch" << (success ? "" : " (FAIL!)") << endl;
+  }
+
+  // The streaming file multiplication, checked against the in-memory one, with blocks small enough to need many columns
+  {
+    mt19937 rng(9);
+    filesystem::path directory = filesystem::temp_directory_path();
+    string x_path = (directory / "karatsuba_x.txt").string(), y_path = (directory / "karatsuba_y.txt").string();
+    string output_path = (directory / "karatsuba_product.txt").string();
+    vector<pair<string, string>> operands = {{"0", "123"}, {"-5", "2"}, {"3", "3"}, {"-000999999999999", "-1000000000\n"}};
+    for (int n : {40, 1000, 5000})
+    {
+      string x = "-", y;
+      for (int i = 0; i < n; ++i)
+        x += '0' + (i == 0 ? 1 + rng() % 9 : rng() % 10);
+      for (int i = 0; i < 3 * n + 7; ++i)
+        y += '0' + (i == 0 ? 1 + rng() % 9 : rng() % 10);
+      operands.push_back({x, y + "\r\n"});
+    }
+    for (auto const &operand : operands)
+    {
+      ofstream(x_path) << operand.first;
+      ofstream(y_path) << operand.second;
+      StreamMultiplyOptions options;
+      options.block_chunks = 7;
+      options.validate_bytes = 64;
+      bool success = multiplyFiles(x_path, y_path, output_path, options);
+      string product;
+      getline(ifstream(output_path), product);
+      string expected = multiply(operand.first, operand.second.substr(0, operand.second.find_first_of("\r\n")));
+      success = success && product == expected;
+      cout << operand.first.length() << " x " << operand.second.length() << " bytes: Files" << (success ? "" : " (FAIL!)") << endl;
+    }
+    ofstream(x_path) << "12a4";
+    bool rejected = !multiplyFiles(x_path, y_path, output_path);
+    cout << "Invalid digits: Files" << (rejected ? "" : " (FAIL!)") << endl;
+    for (string const &path : {x_path, y_path, output_path})
+      filesystem::remove(path);
+  }
+
+  // The exponent fit of the benchmark, on exact power laws
+  {
+    vector<BenchmarkResult> results;
+    for (int digits : {10, 1000, 100000})
+    {
+      results.push_back({"quadratic", digits, 0, 1e-9 * digits * digits, 0});
+      results.push_back({"linear", digits, 0, 1e-9 * digits, 0});
+    }
+    bool success = abs(fitExponent(results, "quadratic", 1000) - 2) < 1e-9 && abs(fitExponent(results, "linear", 0) - 1) < 1e-9;
+    cout << "Power laws: Fitted exponent" << (success ? "" : " (FAIL!)") << endl;
+  }
+
   // Assignment question
   {
     string x = "3141592653589793238462643383279502884197169399375105820974944592";
     string y = "2718281828459045235360287471352662497757247093699959574966967627";
     cout << "Assignment Q: " << x << " * " << y << " = " << multiply(x, y) << endl;
   }
-}
\ No newline at end of file
+}
@@ -1,6 +1,26 @@
 #include <iostream>
 #include <vector>
 #include <algorithm>
+#include <random>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <cctype>
+#include <climits>
+#include <charconv>
+#include <memory>
+#include <fstream>
+#include <filesystem>
+#include <iterator>
+#include <functional>
+#include <type_traits>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define MERGESORT_X86_KERNELS
+#endif
 
 using namespace std;
 
@@ -30,67 +50,751 @@ ostream &operator<<(ostream &os, vector<int> const &v)
    return os;
 }
 
-// Merge the sorted subarrays specified by the ranges [start_a, end_a] and [start_b, end_b]
-// Assumption: the subarrays are contiguous, i.e. if you iterate from start_a to end_b inclusive you will have traversed both subarrays
-void merge(vector<int> &v, int start_a, int end_a, int start_b, int end_b)
+// Merge kernels: merge the sorted arrays a[0, n_a) and b[0, n_b) into out[0, n_a + n_b), which must not overlap either of
+// them. Equal ints are indistinguishable, so every kernel produces the same output; the one used by merge() is picked once
+// at startup (see selectMergeKernel()), so the same binary runs everywhere
+typedef void (*MergeKernel)(int const *a, int n_a, int const *b, int n_b, int *out);
+
+// One comparison per element, with an unpredictable branch on random input. Ties are taken from a first
+void mergeBranching(int const *a, int n_a, int const *b, int n_b, int *out)
+{
+   int i = 0, j = 0;
+   while (i < n_a && j < n_b)
+   {
+      if (a[i] <= b[j])
+         *out++ = a[i++];
+      else
+         *out++ = b[j++];
+   }
+   out = copy(a + i, a + n_a, out);
+   copy(b + j, b + n_b, out);
+}
+
+// The same merge with the branch turned into conditional moves and index arithmetic
+void mergeBranchless(int const *a, int n_a, int const *b, int n_b, int *out)
+{
+   int i = 0, j = 0;
+   while (i < n_a && j < n_b)
+   {
+      int x = a[i], y = b[j];
+      bool take_b = y < x;
+      *out++ = take_b ? y : x;
+      i += !take_b;
+      j += take_b;
+   }
+   out = copy(a + i, a + n_a, out);
+   copy(b + j, b + n_b, out);
+}
+
+#if defined(MERGESORT_X86_KERNELS)
+// Sorts the bitonic sequence v: compare-exchanges at distance 4, 2 and 1, each a min, a max and a blend
+__attribute__((target("avx2"))) inline __m256i bitonicSort8(__m256i v)
+{
+   __m256i swapped = _mm256_permute2x128_si256(v, v, 1);
+   v = _mm256_blend_epi32(_mm256_min_epi32(v, swapped), _mm256_max_epi32(v, swapped), 0xF0);
+   swapped = _mm256_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2));
+   v = _mm256_blend_epi32(_mm256_min_epi32(v, swapped), _mm256_max_epi32(v, swapped), 0xCC);
+   swapped = _mm256_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1));
+   return _mm256_blend_epi32(_mm256_min_epi32(v, swapped), _mm256_max_epi32(v, swapped), 0xAA);
+}
+
+// Bitonic merge network of 16: the sorted vectors low and high become the smallest and the largest 8 of their union, sorted.
+// Reversing high makes the 16 elements a bitonic sequence, which one min/max step splits into two bitonic halves
+__attribute__((target("avx2"))) inline void bitonicMerge16(__m256i &low, __m256i &high)
+{
+   __m256i reversed = _mm256_permutevar8x32_epi32(high, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+   __m256i minima = _mm256_min_epi32(low, reversed), maxima = _mm256_max_epi32(low, reversed);
+   low = bitonicSort8(minima);
+   high = bitonicSort8(maxima);
+}
+
+// Merges 8 elements at a time: the 8 largest elements of each network are carried into the next one, together with the
+// next 8 from whichever input has the smaller next element, and the 8 smallest are final
+__attribute__((target("avx2"))) void mergeAvx2(int const *a, int n_a, int const *b, int n_b, int *out)
+{
+   if (n_a < 8 || n_b < 8)
+      return mergeBranchless(a, n_a, b, n_b, out);
+
+   __m256i low = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(a));
+   __m256i high = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(b));
+   int i = 8, j = 8;
+   for (;;)
+   {
+      bitonicMerge16(low, high);
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(out), low);
+      out += 8;
+      if (i + 8 > n_a || j + 8 > n_b)
+         break;
+      bool take_a = a[i] <= b[j];
+      low = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(take_a ? a + i : b + j));
+      i += take_a ? 8 : 0;
+      j += take_a ? 0 : 8;
+   }
+
+   // Fewer than 8 elements are left in one of the inputs: merge the carried ones into the rest, which is at most 15 steps
+   // before one of a and b runs dry, then finish with the scalar kernel
+   int carried[8], k = 0;
+   _mm256_storeu_si256(reinterpret_cast<__m256i *>(carried), high);
+   while (k < 8)
+   {
+      if (i < n_a && a[i] < carried[k] && (j >= n_b || a[i] <= b[j]))
+         *out++ = a[i++];
+      else if (j < n_b && b[j] < carried[k])
+         *out++ = b[j++];
+      else
+         *out++ = carried[k++];
+   }
+   mergeBranchless(a + i, n_a - i, b + j, n_b - j, out);
+}
+#endif
+
+MergeKernel selectMergeKernel()
+{
+#if defined(MERGESORT_X86_KERNELS)
+   __builtin_cpu_init();
+   if (__builtin_cpu_supports("avx2"))
+      return mergeAvx2;
+#endif
+   return mergeBranchless;
+}
+
+MergeKernel mergeKernel = selectMergeKernel();
+
+// Merge the sorted arrays a[0, n_a) and b[0, n_b) into out[0, n_a + n_b), which must not overlap either of them
+void merge(int const *a, int n_a, int const *b, int n_b, int *out)
+{
+   mergeKernel(a, n_a, b, n_b, out);
+}
+
+// Sort v[0, n) using buffer[0, n) as the other half of a "ping-pong" pair: each level of the recursion sorts both halves
+// into the array it is not merging into, then merges them into the one it is, so the levels alternate between v and
+// buffer and nothing is ever copied back. The sorted result ends up in buffer if into_buffer, otherwise in v
+void mergeSortPingPong(int *v, int *buffer, int n, bool into_buffer)
+{
+   if (n <= 1)
+   {
+      if (into_buffer && n == 1)
+         buffer[0] = v[0];
+      return;
+   }
+
+   int n_a = n / 2;
+   mergeSortPingPong(v, buffer, n_a, !into_buffer);
+   mergeSortPingPong(v + n_a, buffer + n_a, n - n_a, !into_buffer);
+   if (into_buffer)
+      merge(v, n_a, v + n_a, n - n_a, buffer);
+   else
+      merge(buffer, n_a, buffer + n_a, n - n_a, v);
+}
+
+// Sort v[0, n), using buffer as scratch space. The buffer only grows if it is shorter than n, so reusing it across many
+// sorts makes them allocation-free
+void mergeSort(int *v, int n, vector<int> &buffer)
+{
+   if (int(buffer.size()) < n)
+      buffer.resize(n);
+   mergeSortPingPong(v, buffer.data(), n, false);
+}
+
+// Sort the subarray specified by the range [start, end]
+void mergeSort(vector<int> &v, int start, int end)
+{
+   if (start >= end)
+      return;
+
+   vector<int> buffer;
+   mergeSort(v.data() + start, end - start + 1, buffer);
+}
+
+void mergeSort(vector<int> &v)
+{
+   mergeSort(v, 0, v.size() - 1);
+}
+
+// Bottom-up mergesort tuning, in elements. Runs of INSERTION_RUN elements are sorted with insertion sort, then merged in
+// passes of doubling width. The passes are blocked so that each block of L1_BLOCK elements (which, with its half of the
+// buffer, fits in a 32 KiB L1 cache) goes through all of its passes before the next block is touched, and likewise for
+// blocks of L2_BLOCK elements and the L2 cache; only the last passes stream over the whole array
+int const INSERTION_RUN = 32;
+int const L1_BLOCK = 1 << 12;
+int const L2_BLOCK = 1 << 16;
+
+void insertionSort(int *v, int n)
+{
+   for (int i = 1; i < n; ++i)
+   {
+      int key = v[i], j = i - 1;
+      for (; j >= 0 && v[j] > key; --j)
+         v[j + 1] = v[j];
+      v[j + 1] = key;
+   }
+}
+
+// Merge each pair of adjacent sorted runs of length width in src[0, n) into dst[0, n)
+void mergePass(int const *src, int *dst, int n, int width)
+{
+   for (int start = 0; start < n; start += 2 * width)
+   {
+      int middle = min(start + width, n), end = min(start + 2 * width, n);
+      merge(src + start, middle - start, src + middle, end - middle, dst + start);
+   }
+}
+
+// Iterative, cache-blocked mergesort of v[0, n), using buffer[0, n) as scratch space like the top-down version
+// The sorted result ends up in buffer if into_buffer, otherwise in v
+void mergeSortBottomUp(int *v, int *buffer, int n, bool into_buffer)
+{
+   // The passes alternate between v and buffer, so start the runs in whichever one makes the last pass end in the right one
+   int passes = 0;
+   for (int width = INSERTION_RUN; width < n; width *= 2)
+      ++passes;
+   int *target = into_buffer ? buffer : v, *other = into_buffer ? v : buffer;
+   int *src = passes % 2 == 0 ? target : other, *dst = passes % 2 == 0 ? other : target;
+   for (int start = 0; start < n; start += INSERTION_RUN)
+   {
+      int length = min(INSERTION_RUN, n - start);
+      if (src != v)
+         copy(v + start, v + start + length, src + start);
+      insertionSort(src + start, length);
+   }
+
+   int width = INSERTION_RUN;
+   for (int block : {L1_BLOCK, L2_BLOCK, max(n, 1)})
+   {
+      int first_width = width, block_passes = 0;
+      for (; width < block && width < n; width *= 2)
+         ++block_passes;
+      for (int start = 0; start < n; start += block)
+      {
+         int *from = src, *to = dst;
+         for (int pass = 0, w = first_width; pass < block_passes; ++pass, w *= 2)
+         {
+            mergePass(from + start, to + start, min(block, n - start), w);
+            swap(from, to);
+         }
+      }
+      if (block_passes % 2 == 1)
+         swap(src, dst);
+   }
+}
+
+void mergeSortBottomUp(int *v, int n, vector<int> &buffer)
+{
+   if (int(buffer.size()) < n)
+      buffer.resize(n);
+   mergeSortBottomUp(v, buffer.data(), n, false);
+}
+
+void mergeSortBottomUp(vector<int> &v)
+{
+   vector<int> buffer;
+   mergeSortBottomUp(v.data(), v.size(), buffer);
+}
+
+// Merge path ("co-ranking"): the number of elements of a among the first d elements of the stable merge of a[0, n_a) and
+// b[0, n_b). Cutting both inputs there splits the merge into two halves that can be merged independently
+int coRank(int d, int const *a, int n_a, int const *b, int n_b)
+{
+   int low = max(0, d - n_b), high = min(d, n_a);
+   while (low < high)
+   {
+      // Taking i elements from a (and d - i from b) is too few if a[i] still comes before b[d - i - 1] in the merge
+      int i = low + (high - low) / 2;
+      if (a[i] <= b[d - i - 1])
+         low = i + 1;
+      else
+         high = i;
+   }
+   return low;
+}
+
+// Multithreaded mergesort of v[0, n), using buffer as scratch space. v is cut into one chunk per thread, the chunks are
+// sorted concurrently, and then adjacent sorted runs are merged pairwise in rounds. Each merge of a round is itself cut
+// with merge path into one piece per thread in its share of the output, so the last rounds, which have few merges, still
+// keep every thread busy. Every piece is a slice of the same stable merge, so the output is exactly that of the sequential
+// sort, whatever the number of threads
+void mergeSortParallel(int *v, int n, vector<int> &buffer, int threads)
+{
+   if (int(buffer.size()) < n)
+      buffer.resize(n);
+   threads = max(1, min(threads, n / L1_BLOCK)); // a thread per chunk smaller than this would cost more than it saves
+
+   vector<int> bounds; // the sorted runs are [bounds[r], bounds[r + 1])
+   for (int t = 0; t <= threads; ++t)
+      bounds.push_back(int64_t(n) * t / threads);
+   int rounds = 0;
+   for (int runs = threads; runs > 1; runs = (runs + 1) / 2)
+      ++rounds;
+
+   // The rounds alternate between v and buffer, so sort the chunks into whichever one makes the last round end in v
+   bool into_buffer = rounds % 2 == 1;
+   int *src = into_buffer ? buffer.data() : v, *dst = into_buffer ? v : buffer.data();
+   {
+      vector<thread> workers;
+      for (int t = 0; t < threads; ++t)
+         workers.emplace_back([=, &buffer]() { mergeSortBottomUp(v + bounds[t], buffer.data() + bounds[t], bounds[t + 1] - bounds[t], into_buffer); });
+      for (thread &worker : workers)
+         worker.join();
+   }
+
+   for (; bounds.size() > 2; swap(src, dst))
+   {
+      vector<int> merged_bounds;
+      vector<thread> workers;
+      for (size_t r = 0; r + 1 < bounds.size(); r += 2)
+      {
+         // An odd run out is merged with an empty one, which copies it across
+         int start = bounds[r], middle = bounds[r + 1], end = r + 2 < bounds.size() ? bounds[r + 2] : middle;
+         merged_bounds.push_back(start);
+         int const *a = src + start, *b = src + middle;
+         int n_a = middle - start, n_b = end - middle;
+         int pieces = max<int64_t>(1, int64_t(threads) * (end - start) / n);
+         for (int p = 0; p < pieces; ++p)
+         {
+            int first = int64_t(end - start) * p / pieces, last = int64_t(end - start) * (p + 1) / pieces;
+            workers.emplace_back([=]() {
+               int first_a = coRank(first, a, n_a, b, n_b), last_a = coRank(last, a, n_a, b, n_b);
+               merge(a + first_a, last_a - first_a, b + first - first_a, (last - last_a) - (first - first_a), dst + start + first);
+            });
+         }
+      }
+      merged_bounds.push_back(n);
+      for (thread &worker : workers)
+         worker.join();
+      bounds = merged_bounds;
+   }
+}
+
+void mergeSortParallel(vector<int> &v, int threads = thread::hardware_concurrency())
+{
+   vector<int> buffer;
+   mergeSortParallel(v.data(), v.size(), buffer, threads);
+}
+
+// Projection that leaves the elements as they are
+struct Identity
+{
+   template <typename T>
+   T &&operator()(T &&x) const
+   {
+      return forward<T>(x);
+   }
+};
+
+// Generic merge of the sorted ranges [a, a_last) and [b, b_last) into out, ordered by comp on the projections of the
+// elements. Ties are taken from a first, so the merge is stable
+template <typename InputIt, typename OutputIt, typename Compare, typename Projection>
+OutputIt merge(InputIt a, InputIt a_last, InputIt b, InputIt b_last, OutputIt out, Compare &comp, Projection &proj)
+{
+   while (a != a_last && b != b_last)
+   {
+      if (comp(proj(*b), proj(*a)))
+         *out++ = move(*b++);
+      else
+         *out++ = move(*a++);
+   }
+   out = move(a, a_last, out);
+   return move(b, b_last, out);
+}
+
+// The ping-pong mergesort above for any random-access range: sorts v[0, n) into buffer if into_buffer, otherwise into v,
+// with insertion sort below INSERTION_RUN elements
+template <typename RandomIt, typename BufferIt, typename Compare, typename Projection>
+void mergeSortPingPong(RandomIt v, BufferIt buffer, int n, bool into_buffer, Compare &comp, Projection &proj)
+{
+   if (n <= INSERTION_RUN)
+   {
+      for (int i = 1; i < n; ++i)
+         for (int j = i; j > 0 && comp(proj(v[j]), proj(v[j - 1])); --j)
+            swap(v[j], v[j - 1]);
+      if (into_buffer)
+         move(v, v + n, buffer);
+      return;
+   }
+
+   int n_a = n / 2;
+   mergeSortPingPong(v, buffer, n_a, !into_buffer, comp, proj);
+   mergeSortPingPong(v + n_a, buffer + n_a, n - n_a, !into_buffer, comp, proj);
+   if (into_buffer)
+      merge(v, v + n_a, v + n_a, v + n, buffer, comp, proj);
+   else
+      merge(buffer, buffer + n_a, buffer + n_a, buffer + n, v, comp, proj);
+}
+
+// Stable sort of [first, last) by comp on the projections of the elements, e.g.
+//    mergeSort(records.begin(), records.end(), less<>(), [](Record const &r) { return r.key; });
+// Contiguous ints in ascending order go to the int sort, and so to the SIMD merge kernels
+template <typename RandomIt, typename Compare = less<>, typename Projection = Identity>
+void mergeSort(RandomIt first, RandomIt last, Compare comp = Compare(), Projection proj = Projection())
+{
+   typedef typename iterator_traits<RandomIt>::value_type T;
+   int n = last - first;
+   if (n < 2)
+      return;
+
+   bool constexpr contiguous = is_pointer<RandomIt>::value || is_same<RandomIt, typename vector<T>::iterator>::value;
+   if constexpr (contiguous && is_same<T, int>::value && is_same<Projection, Identity>::value &&
+                 (is_same<Compare, less<>>::value || is_same<Compare, less<int>>::value))
+   {
+      vector<int> buffer;
+      mergeSort(&*first, n, buffer);
+   }
+   else
+   {
+      vector<T> buffer(first, last);
+      mergeSortPingPong(first, buffer.begin(), n, false, comp, proj);
+   }
+}
+
+// Moves the elements of [first, first + order.size()) so that element order[i].second comes i-th
+template <typename RandomIt, typename Key>
+void applyOrder(RandomIt first, vector<pair<Key, int>> const &order)
+{
+   vector<typename iterator_traits<RandomIt>::value_type> sorted;
+   sorted.reserve(order.size());
+   for (auto const &entry : order)
+      sorted.push_back(move(first[entry.second]));
+   move(sorted.begin(), sorted.end(), first);
+}
+
+// Key-value mode: stable sort of [first, last) by comp on key(element), for elements that are expensive to move. Only
+// (key, index) pairs are moved while sorting, and then every element is moved once to its place
+template <typename RandomIt, typename KeyFunction, typename Compare = less<>>
+void mergeSortByKey(RandomIt first, RandomIt last, KeyFunction key, Compare comp = Compare())
+{
+   typedef decay_t<decltype(key(*first))> Key;
+   vector<pair<Key, int>> order;
+   order.reserve(last - first);
+   for (RandomIt it = first; it != last; ++it)
+      order.push_back({key(*it), int(it - first)});
+
+   mergeSort(order.begin(), order.end(), comp, [](pair<Key, int> const &entry) -> Key const & { return entry.first; });
+   applyOrder(first, order);
+}
+
+// External mergesort options. Sizes are in bytes
+struct ExternalSortOptions
+{
+   size_t memory_budget = size_t(1) << 30; // for a run and its sort buffer, and for the merge buffers
+   size_t io_buffer = size_t(1) << 22;     // per buffered sequential read or write
+   int threads = thread::hardware_concurrency();
+   string temp_directory; // where the runs are spilled; the directory of the output if empty
+};
+
+// Buffered reader of whitespace-separated decimal ints from a text file, a large block at a time
+class TextIntReader
+{
+   FILE *file;
+   vector<char> buffer;
+   size_t position = 0, length = 0;
+   bool failed = false;
+
+   // Next character, refilling the buffer as needed, or EOF
+   int Peek()
+   {
+      if (position == length)
+      {
+         length = fread(buffer.data(), 1, buffer.size(), file);
+         position = 0;
+         if (length == 0)
+            return EOF;
+      }
+      return buffer[position];
+   }
+
+public:
+   TextIntReader(FILE *_file, size_t buffer_size) : file(_file), buffer(buffer_size)
+   { /* nothing */ }
+
+   // Reads the next int into x, returning false at the end of the file or on anything that is not an int
+   bool Next(int &x)
+   {
+      int c;
+      while ((c = Peek()) != EOF && isspace(c))
+         ++position;
+      if (c == EOF)
+         return false;
+
+      bool negative = c == '-';
+      position += negative;
+      int64_t value = 0;
+      int digits = 0;
+      for (; (c = Peek()) != EOF && c >= '0' && c <= '9' && digits <= 10; ++position, ++digits)
+         value = value * 10 + (c - '0');
+      value = negative ? -value : value;
+      failed = digits == 0 || digits > 10 || value < INT32_MIN || value > INT32_MAX || (c != EOF && !isspace(c));
+      x = int(value);
+      return !failed;
+   }
+
+   bool Failed() const
+   {
+      return failed;
+   }
+};
+
+// Buffered writer of ints to a file, either as text (one per line) or in the raw binary format of the runs
+class IntWriter
 {
-   vector<int> scratch;
+   FILE *file;
+   vector<char> buffer;
+   size_t length = 0;
+   bool text;
+   bool failed = false;
+
+public:
+   IntWriter(FILE *_file, size_t buffer_size, bool _text) : file(_file), buffer(max<size_t>(buffer_size, 64)), text(_text)
+   { /* nothing */ }
 
-   int a = start_a, b = start_b;
-   for (; a <= end_a && b <= end_b;)
+   ~IntWriter()
    {
-      if (v[a] <= v[b])
+      Flush();
+   }
+
+   void Write(int x)
+   {
+      if (buffer.size() - length < 16)
+         Flush();
+      if (text)
       {
-         scratch.push_back(v[a]);
-         a++;
+         length = to_chars(buffer.data() + length, buffer.data() + buffer.size(), x).ptr - buffer.data();
+         buffer[length++] = '\n';
       }
       else
       {
-         scratch.push_back(v[b]);
-         b++;
+         memcpy(buffer.data() + length, &x, sizeof(x));
+         length += sizeof(x);
       }
    }
+
+   // Returns false if any write so far has failed
+   bool Flush()
    {
-      int start = 0, end = 0;
-      if (a <= end_a)
+      if (length > 0)
+         failed = failed || fwrite(buffer.data(), 1, length, file) != length || fflush(file) != 0;
+      length = 0;
+      return !failed;
+   }
+};
+
+// Buffered reader of a run spilled in the raw binary format
+class RunReader
+{
+   FILE *file;
+   vector<int> buffer;
+   size_t position = 0, length = 0;
+
+public:
+   RunReader(FILE *_file, size_t buffer_size) : file(_file), buffer(max<size_t>(buffer_size / sizeof(int), 1))
+   { /* nothing */ }
+
+   bool Next(int &x)
+   {
+      if (position == length)
       {
-         start = a;
-         end = end_a + 1;
+         length = fread(buffer.data(), sizeof(int), buffer.size(), file);
+         position = 0;
+         if (length == 0)
+            return false;
       }
-      else if (b <= end_b)
+      x = buffer[position++];
+      return true;
+   }
+};
+
+// Tournament tree of losers for a k-way merge. Leaf k + s stands for source s, and every inner node holds the source that
+// lost the match played there, with the overall winner (the source with the smallest head) in tree[0]. Replacing the
+// winner's head only replays the matches on the path from its leaf to the root, which holds exactly the sources it has to
+// beat: ceil(log2(k)) comparisons per element, whatever happened elsewhere in the tree
+class LoserTree
+{
+   int k;
+   vector<int> tree;
+   vector<int64_t> heads; // the head of each source, or EXHAUSTED
+
+   // Whether source a comes before source b; ties go to the lower index, so the merge is stable
+   bool Beats(int a, int b) const
+   {
+      return heads[a] < heads[b] || (heads[a] == heads[b] && a < b);
+   }
+
+public:
+   static int64_t const EXHAUSTED = INT64_MAX; // above every int, so exhausted sources never win
+
+   LoserTree(vector<int64_t> const &_heads) : k(_heads.size()), tree(max(k, 1)), heads(_heads)
+   {
+      vector<int> winners(2 * k);
+      for (int s = 0; s < k; ++s)
+         winners[k + s] = s;
+      for (int node = k - 1; node >= 1; --node)
       {
-         start = b;
-         end = end_b + 1;
+         int a = winners[2 * node], b = winners[2 * node + 1];
+         winners[node] = Beats(a, b) ? a : b;
+         tree[node] = Beats(a, b) ? b : a;
       }
-      for (int i = start; i < end; ++i)
-         scratch.push_back(v[i]);
+      tree[0] = k == 1 ? 0 : winners[1];
    }
 
-   for (int i = start_a; i <= end_b; ++i)
-      v[i] = scratch[i - start_a];
-}
+   int Winner() const
+   {
+      return tree[0];
+   }
 
-void mergeSort(vector<int> &v, int start, int end)
+   int64_t WinnerHead() const
+   {
+      return heads[tree[0]];
+   }
+
+   // Sets the head of the winning source to head (EXHAUSTED if it has run dry) and finds the new winner
+   void ReplaceWinner(int64_t head)
+   {
+      int winner = tree[0];
+      heads[winner] = head;
+      for (int node = (k + winner) / 2; node >= 1; node /= 2)
+         if (Beats(tree[node], winner))
+            swap(tree[node], winner);
+      tree[0] = winner;
+   }
+};
+
+// k-way merge of the runs in run_paths into writer, with one read buffer of buffer_size bytes per run
+bool mergeRuns(vector<string> const &run_paths, size_t buffer_size, IntWriter &writer)
 {
-   if (start >= end)
-      return;
+   vector<unique_ptr<FILE, int (*)(FILE *)>> files;
+   vector<RunReader> readers;
+   vector<int64_t> heads;
+   for (string const &path : run_paths)
+   {
+      files.emplace_back(fopen(path.c_str(), "rb"), fclose);
+      if (files.back() == nullptr)
+         return false;
+      readers.emplace_back(files.back().get(), buffer_size);
+      int x;
+      heads.push_back(readers.back().Next(x) ? x : LoserTree::EXHAUSTED);
+   }
 
-   int start_a = start;
-   int end_a = start + (end - start) / 2;
-   int start_b = end_a + 1;
-   int end_b = end;
-   mergeSort(v, start_a, end_a);
-   mergeSort(v, start_b, end_b);
-   merge(v, start_a, end_a, start_b, end_b);
+   LoserTree tree(heads);
+   while (tree.WinnerHead() != LoserTree::EXHAUSTED)
+   {
+      writer.Write(int(tree.WinnerHead()));
+      int x;
+      tree.ReplaceWinner(readers[tree.Winner()].Next(x) ? x : LoserTree::EXHAUSTED);
+   }
+   return writer.Flush();
 }
 
-void mergeSort(vector<int> &v)
+// Sorts the whitespace-separated ints in the text file at input_path into a text file at output_path (one int per line),
+// for files much larger than memory. Runs of as many ints as fit in the memory budget (with their sort buffer) are sorted
+// with the parallel mergesort and spilled to temporary files as raw binary ints; then the runs are merged with a loser
+// tree, as many at a time as there are I/O buffers in the budget, over as many passes as that takes. Every read and write
+// is a large sequential block. Returns false (with a message on cerr) on error
+bool externalMergeSort(string const &input_path, string const &output_path, ExternalSortOptions const &options = ExternalSortOptions())
 {
-   mergeSort(v, 0, v.size() - 1);
+   unique_ptr<FILE, int (*)(FILE *)> input(fopen(input_path.c_str(), "rb"), fclose);
+   if (input == nullptr)
+   {
+      cerr << "Could not open " << input_path << endl;
+      return false;
+   }
+   filesystem::path temp_directory = options.temp_directory;
+   if (temp_directory.empty())
+      temp_directory = filesystem::absolute(output_path).parent_path();
+   string run_prefix = (temp_directory / filesystem::path(output_path).filename()).string() + ".run";
+
+   // Run formation: the run and its sort buffer take the whole budget
+   size_t run_capacity = max<size_t>(1, options.memory_budget / (2 * sizeof(int)));
+   vector<string> run_paths;
+   auto cleanUp = [&]() {
+      for (string const &path : run_paths)
+         filesystem::remove(path);
+   };
+   {
+      TextIntReader reader(input.get(), options.io_buffer);
+      vector<int> run, buffer;
+      run.reserve(run_capacity);
+      for (bool done = false; !done;)
+      {
+         run.clear();
+         int x;
+         while (run.size() < run_capacity && reader.Next(x))
+            run.push_back(x);
+         done = run.size() < run_capacity;
+         if (reader.Failed())
+         {
+            cerr << "Could not read an int from " << input_path << endl;
+            cleanUp();
+            return false;
+         }
+         if (run.empty() && !run_paths.empty())
+            break;
+
+         mergeSortParallel(run.data(), run.size(), buffer, options.threads);
+         run_paths.push_back(run_prefix + to_string(run_paths.size()));
+         unique_ptr<FILE, int (*)(FILE *)> file(fopen(run_paths.back().c_str(), "wb"), fclose);
+         if (file == nullptr || fwrite(run.data(), sizeof(int), run.size(), file.get()) != run.size())
+         {
+            cerr << "Could not write the run " << run_paths.back() << endl;
+            cleanUp();
+            return false;
+         }
+      }
+   }
+
+   // Merge passes: each merge gets one buffer per run and one for its output, so merges of many runs take several passes
+   int fan_in = max<size_t>(2, options.memory_budget / options.io_buffer - 1);
+   size_t read_buffer = options.memory_budget / (fan_in + 1);
+   for (int pass = 0; int(run_paths.size()) > fan_in; ++pass)
+   {
+      vector<string> merged_paths;
+      for (size_t first = 0; first < run_paths.size(); first += fan_in)
+      {
+         vector<string> group(run_paths.begin() + first, run_paths.begin() + min(run_paths.size(), first + fan_in));
+         merged_paths.push_back(run_prefix + to_string(pass) + "." + to_string(merged_paths.size()));
+         unique_ptr<FILE, int (*)(FILE *)> file(fopen(merged_paths.back().c_str(), "wb"), fclose);
+         IntWriter writer(file.get(), read_buffer, false);
+         bool success = file != nullptr && mergeRuns(group, read_buffer, writer);
+         for (string const &path : group)
+            filesystem::remove(path);
+         if (!success)
+         {
+            cerr << "Could not merge into " << merged_paths.back() << endl;
+            run_paths = vector<string>(run_paths.begin() + min(run_paths.size(), first + fan_in), run_paths.end());
+            run_paths.insert(run_paths.end(), merged_paths.begin(), merged_paths.end());
+            cleanUp();
+            return false;
+         }
+      }
+      run_paths = merged_paths;
+   }
+
+   unique_ptr<FILE, int (*)(FILE *)> output(fopen(output_path.c_str(), "wb"), fclose);
+   bool success = output != nullptr;
+   if (success)
+   {
+      IntWriter writer(output.get(), read_buffer, true);
+      success = mergeRuns(run_paths, read_buffer, writer);
+   }
+   if (!success)
+      cerr << "Could not write " << output_path << endl;
+   cleanUp();
+   return success;
 }
 
-int main()
+int main(int argc, char *argv[])
 {
+   if (argc > 3 && string(argv[1]) == "--external")
+   {
+      ExternalSortOptions options;
+      if (argc > 4)
+         options.memory_budget = size_t(stoi(argv[4])) << 20;
+      auto start = chrono::steady_clock::now();
+      bool success = externalMergeSort(argv[2], argv[3], options);
+      auto end = chrono::steady_clock::now();
+      if (success)
+         cout << "Sorted " << argv[2] << " into " << argv[3] << " in " << chrono::duration<double>(end - start).count() << " s" << endl;
+      return success ? 0 : 1;
+   }
+
    vector<vector<int>> test_cases = {
        {8, 4, 5, 4, 9, 2, 0, 1},
        {9, 1, 90, 20, 23},
@@ -109,6 +813,14 @@ int main()
        {2522, 4507, -4977, 2724, 1751, -1106, -4090, 2438, 604, 1778, -4007, -29, -4599, -3677, 2779, -4707, -120, -4180, -477, 1010, 1490, -2424, 4856, 1939, 4261, 1714, -648, -707, 2318, 2973, 4536, 2917, -4439, -1228, -2203, 3005, -2690, -401, -2653, -2247, -4075, -1981, 1514, -1190, -1550, 2586, 4908, 3291, 4729, 4443, 2798, -3901, 1713, 1196, 1286, 477, -716, 4297, 1549, 4139, 3043, 4105, -1113, -4655, -4446, 4189, -3039, 3003, -1838, -2074, -2442, 1898, -4327, -1808, -1121, 1932, -3271, 3859, 4229, 1322, -2698, -3623, 4442, 343, 1250, 3760, 1785, -3424, 3872, 2201, 4605, -3581, -2901, -63, -288, 342, 1153, 3938, -3530, -4392, 2013, 1694, -3020, -4308, -4398, -89, 1047, -174, -4114, -1926, -4822, -1114, 2545, -3451, 1885, -899, 4289, -3480, 3208, -4778, 3633, -968, -2324, 742, 3441, -1246, 1775, 2564, -3941, 2249, 4944, -4296, -2263, -1897, 722, -2467, 854, 1579, 202, -4994, 1908, -249, -353, 4045, 745, -2155, -1852, -2835, -1605, -4387, 1655, 3557, 4845, -631, -1593, 3123, -4813, 3081, 3384, -4768, 4449, -1858, 709, -4520, -4295, -2798, -3401, -4936, -1766, 3644, 3598, -2503, -1825, 4872, 930, 3578, 1024, -747, -4571, -3069, 4574, -2858, -3731, 3600, 3241, 1371, 3629, 0, -909, -1618, 2030, 2679, 1211, 4082, 97, -608, -4498, 185, 2058, 265, 4181, 4188, -3028, -4582, 646, 3091, 3643, -3504, 588, 69, 4148, -207, -3832, 2075, 56, -1389, 4378, 1964, 1546, -342, 2045, 3678, -668, -2662, 1871, 2665, 669, -3466, 1997, -4013, 3327, -2477, -1624, -1191, -4703, -4036, -3005, 4776, 3067, -234, -2925, 907, 3034, 1551, -2636, -196, -3301, -3205, -1803, 778, 231, -4150, 2237, 266, -910, 4150, -1634, 2194, -2593, -1527, 3676, 3400, -1935, 3006, -3120, -728, 2424, -3361, 68, 825, -862, -3548, -921, -1188, 673, 1099, 1876, -2951, 473, 797, -3801, -1602, -829, 716, -282, -2537, 1140, 485, -1342, 924, -3633, -494, 864, -2756, -2878, -2381, -1725, -4309, 2041, -4723, -987, 708, 4810, 4120, -2507, 4485, 2326, 148, 1125, 4594, -1125, 450, 4584, 2341, 1020, 4013, 2976, 963, -4585, -2590, 2895, 2374, -1420, -1666, -2530, -936, -1631, -4100, -1305, 2189, -393, -1354, 3712, -643, 4310, 4521, -679, 1703, -4024, -756, -976, 253, -637, -4424, -1231, 2989, -3640, -1918, 4541, 1072, 3502, -760, -2489, -4962, 1881, 649, -813, -1395, 4971, -2153, 4147, 2396, -2212, -4928, -2079, -4875, 1653, 3770, 3886, 2822, -4549, -2352, 4428, -717, 1677, -2310, -3907, 4389, -156, -64, -2412, 3775, -434, 3391, -1154, -4427, -2602, -4539, -1127, 2433, 152, 229, -3375, -2977, -1653, 1109, 2218, 4959, -4906, -3323, -1448, -3735, -3308, -2110, 1425, 2354, -1341, -1441, 976, 405, -522, -2702, -688, -1283, -1263, -4548, 3359, 4127, 926, 3737, 2134, 3494, 1230, -1657, -4799, 1854, 4707, 2400, -4051, 2022, -3121, 2945, 4349, 2959, -2177, -2671, -2060, -3450, -4357, -1265, -823, 638, -4124, -4228, 2934, -1312, 555, -3859, -362, -2358, -4425, 3658, 4356, -4920, 3628, -51, 2324, -152, -2346, 1847, 1199, 2098, -4888, -2068, -330, -966, -4423, 3985, 4701, -4542, 1944, -394, 2574, -492, -502, 3472, 4155, 387, -351, -1487, 2102, -2680, -2658, -1795, -17, -3953, 3307, -402, -1645, 4270, -2261, -1135, 4396, -1798, -1743, 4822, -3236, 543, -4141, -4259, -1739, -3995, -1522, -1048, 4431, -3278, 2105, 2690, 61, -1678, 1978, -2445, 4128, -935, -4597, -3137, -4214, -1087, -4792, 2480, -1345, 1073, 1269, -2821, 2799, 3748, 2408, 3937, -4927, 704, -112, -1041, -3555, -180, 4130, -2686, -1036, -1731, -2888, -396, -1514, -2410, -54, 2425, 4674, 3811, -4485, 3895, -3001, 3923, 3072, -2251, -706, 2923, 4633, -999, 621, 1306, -2307, -1020, -2588, 1861, 4920, 3691, 3299, 2815, 654, -2526, 635, 4300, 4992, 2095, 3255, 59, 510, -1335, 1126, 711, -3667, 4665, -3182, 2718, -1831, -3163, -779, -1160, 277, -529, -4240, -4367, -1839, -1467, 4511, 3914, -2949, 866, 1623, -4624, -869, 4763, -1258, 4756, -3486, 136, -1277, -2426, -2108, -2077, 758, -998, 4622, -1227, 2136, -3626, -4784, -1034, 4190, 2757, 2097, -1428, -3986, -979, -4558, -148, -1284, -2308, -2486, -897, -1297, 2077, -3686, 1217, 1633, 2353, 351, 4418, 31, -2699, -882, -3023, 700, -3090, 1962, -4678, -3006, -4347, -2154, -2214, -2962, 3974, 1312, 1327, 535, 4783, -318, -1011, -461, -1430, -3288, 4764, 759, 1558, 1014, -3550, 2410, -2768, -307, -4123, -3714, 2069, 1215, 2998, -269, 3641, 4812, -1906, -599, -1575, 2472, 4222, -2340, 858, -386, 3362, 2140, -2269, 2026, -4131, 1621, -1667, 690, -3275, 1940, -3512, -2789, 4048, -1963, 367, -2431, 2864, 2817, -2796, -4634, -1000, 440, -2879, 2129, -3345, -1630, 4545, 2288, -4281, 1599, -1400, 378, -3773, 4432, -4732, 618, 4863, -1406, -2315, -3254, 909, -2585, 4125, 4569, 965, -3297, 1730, -2604, -546, 1064, 3677, -3599, 1141, 3199, 4083, -4640, 1930, 3209, -3190, -1905, 2029, 1178, -1586, 973, 754, 4669, 1882, -3972, 3334, -3691, -721, 238, 3796, 1497, -4863, -1184, 4063, 4224, -2952, -1454, 137, -3842, -4779, -914, -4595, -2679, -4609, -1619, 3649, 4955, -2549, -2973, 3504, -4511, -3420, 89, -4074, 2645, 3058, -3261, 2544, 871, 3930, 3402, -4059, 3356, -623, -3962, -2856, 2964, 380, -2659, -2769, -4913, -4298, 3559, 4207, -3894, 4455, -2773, -2536, -582, -407, -818, -4349, 2184, 3969, -4411, -846, -4000, -2369, 3343, -1676, -2393, -2785, -4184, -3779, -3520, 416, -192, 4726, -3355, 3138, -2747, 3972, -4391, 3449, 411, 341, -280, 1513, 1511, 2994, -4210, -616, -4666, -3743, 2918, 3266, 1117, 2432, -4908, 2596, -3436, -2708, -1, 2829, 4338, -2022, -1737, 892, 591, -3998, 4683, 4, -3447, 4153, 2155, -2291, -4826, -3822, -236, 4937, 2591, 4079, -4646, 3256, 3831, -1164, 3101, -2405, 2922, -2720, -1691, 4484, -2793, -1085, -1636, -3967, 2560, 4635, -671, 4018, -4744, -3871, 1986, 1236, 2637, -149, 2529, -3056, 3883, 2448, -3331, -251, 2000, 4702, -4508, -3079, 1745, -4027, -1987, -3816, 1339, 2099, 2977, -4008, -3383, 3363, -4945, -964, -4478, 3567, 4060, 413, -1349, -387, -2184, 814, -1093, 931, 2061, -3494, -4326, -287, 1262, 2130, -430, 1679, 4021, -2014, -635, 74, 298, 771, 2927, 4142, 693, 449, 2229, 4043, -4339, 2272, -2624, 189, 4636, -31, -4544, 3113, -1008, -715, 4015, 994, 3682, 388, 2519, 2167, -2637, 1809, 2120, -2928, -3621, -2296, 2489, 1875, -4492, 3951, 3825, 1687, 2642, 3238, -2166, 1635, -1859, -1178, -3762, 3136, 2996, 4033, -2755, 915, -1861, 4118, 4804, 418, 454, -1794, 1545, 3489, 2183, 4638, -1572, -678, -2512, 2951, -2800, -3552, 3668, -1403, -3138, -849, 2561, 3119, 4828, 3166, 4361, -941, 4885, 1615, -1990, -3132, 644, -3173, 2657, 3162, -1411, 4593, 4655, -973, -1173, 3608, 1924, 1926, -3761, 3966, -2240, 368, 1740, 1359, -3788, 1929, -3597, 1054, 3880, -3839, 270, 4892, 3030, 1818, 160, 1777, 3455, -1690, -703, 4586, -4620, 67, -2328, 3152, 2802, 2707, -4375, 1409, 2647, -1864, -1211, -595, -2843, 1266, -4475, 349, -2409, 2638, 2780, -3791, 2892, -2864, -2711, 4470, 1208, -3143, 3093, -1213, -4167, 4240, 3253, -1971, -3544, -571, 210, -803, -1280, -473, 4178, 3919, -3632, 1580, -3590, -2993, -335, -1362, 1769, -1097, -194, -2806, 1883, -3479, -1412, -3314, -121, 1604, -2208, -810, 2137, -3815, -4154, -2816, -3521, 1247, -4099, 1950, -2972, -651, 3169, -3183, 3265, -825, 2575, 2174, 1472, 2924, -2495, 1482, -1325, 3610, -3201, -1466, 2705, 1771, -1980, 2491, -1908, -2183, 1417, -3394, 4109, -3387, -1707, 3150, -84, 2623, -713, 1723, 3184, 212, -847, -279, 2065, -2788, 3111, 217, -3024, -2137, 1264, -4541, 541, -3588, -3561, -3239, 4003, -1576, -878, 4555, -4978, 2646, -1485, 2116, 257, -1004, -580, 1817, 3258, -3490, -836, -4665, -1268, 2046, 4141, 4589, 3456, 4327, -1933, 2383, -1922, 2835, 430, 3076, 2018, 2756, -4891, 3433, -573, -4658, 2483, -1425, -3265, 3902, -3347, -3929, 3684, 472, -4757, -4443, -3213, -4728, -4125, -3364, -2587, -1288, -4371, 990, -4409, 1450, 3090, 2818, 3220, -3975, -1796, -2563, 320, 1302, 2627, -2695, -630, 205, -2832, -4088, 352, -4192, -3914, -2836, 2227, -1142, -590, 1879, -35, 4110, 4771, 483, -3378, -1567, -4668, -2292, -3639, -3324, -1012, -495, -1508, 3757, 2715, -4727, -2450, 982, -1031, -1621, 2893, -3882, -1390, -3594, -3786, -1009, 4064, -704, 3634, -1167, 1106, 688, -3694, -4089, -2714, 436, -939, -3591, -603, -960, 1746, 925, 3, -4825, 3231, 4334, -1994, -3485, 3738, 2865, -3566, -4941, 1660, 1585, -1219, -4144, 4868, 2584, -2792, -1189, -1438, -4471, 235, 149, 1664, -4084, -4743, -246, -773, -14, -2186, 3978, 43, 1163, 3913, 4834, 2107, -700, -1649, 2186, 385, -242, -1892, 4058, 13, -1685, 995, -4229, -2807, -3759, -2300, 1295, 4421, 4558, -4414, 3437, -3442, 3549, -950, 4617, 446, 4122, 1120, -1195, -4474, -453, -1337, 938, 1242, 4215, -4199, -2218, 1563, 2476, -1235, 4216, 3958, -4182, -2873, 1721, 3002, 1685, 1034, -4715, -523, 1131, 518, 3028, 2946, -1290, -2072, -1719, -1708, 1221, 2445, -4909, -3534, -4700, 857, -528, 3812, 4671, -959, 4074, 4348, 1555, -1132, -4746, -4934, -34, 4644, -3370, -497, 2428, -1217, -3695, -3747, -3253, -3413, 1762, 4116, 1175, 4587, 1830, 4904, 2219, -697, -286, 2540, -1119, 4631, -4782, 1860, -1449, 1596, 4434, -3718, -3327, 3122, 3659, 4526, -1014, -2236, 4322, 2360, 4954, -4226, -691, -3624, -2349, 3107, -95, 998, -3525, 4336, -634, 1330, -3200, -4831, 2131, 1575, -2694, 142, 276, -237, -2385, 3100, 2879, -4321, -3160, 3451, -2136, -3109, 2241, -4236, -2105, 2492, -1614, 989, -2438, -3115, 1155, -4097, -4477, 3387, 881, -1468, -165, 2907, 2293, -80, 2281, 2221, 444, -3858, -3421, -2053, -3507, 2133, -4215, 4552, 4719, 1159, -1148, -3184, 433, 2151, 115, 1823, 2210, 4183, 2749, -411, 176, 4789, 38, 3408, 3247, -4973, -904, -3167, -314, -206, 3544, -3262, 1840, 3435, 1466, -923, -2132, -1628, 1041, -4093, -2595, 1820, 2342, -812, 1289, 242, 2128, 4482, 4561, 4833, -2961, 1607, 4426, -4115, -724, -1105, -656, 2498, -1869, -4057, -2483, 4942, 4160, 1245, 2532, 290, -1836, 175, 4512, -2975, -3010, -3166, 4403, -1322, -1833, -3538, -25, -3545, -3304, 1993, 4260, 3013, -2413, 1144, 4411, -2795, 2601, -530, 4932, -181, -970, -2029, -94, -4514, 3994, -1660, -660, 2165, -2425, -1580, 1801, -2783, 816, 2440, 3381, 3726, 1138, 582, 625, -1208, 4625, 714, -1237, -2314, 3615, 326, -1222, 4453, -496, 3062, 3010, 1663, -1701, 3877, -1133, -2696, -2894, -2656, 1212, 3264, -4608, 3735, -3505, -516, -890, -1797, 4086, 2427, -1768, -4923, 4394, 1078, -1894, -4883, 1475, -3130, -4344, -4277, -2752, 107, 4038, 3505, -2633, -620, 336, 2161, 3716, 3249, -3535, 785, -4077, -1075, -4975, -4354, -1672, 4296, 2164, -2096, 1285, 2643, -1868, 3167, 4324, 2536, -4643, -4821, -134, -3938, -1724, 872, 3322, -4304, 2190, 4028, -1848, -443, 2043, -4315, 2708, -3593, 3602, 4386, -2465, 1936, -4850, 4693, -584, -2986, -2567, 1240, 1210, 159, -1298, 17, 2420, -1992, -4406, 2634, 4837, 4263, 4874, 3198, -2267, 2032, -2452, -2082, 4319, -4516, 2908, 4328, -2921, 2223, -833, 3797, 1088, 2262, -2375, 3403, 3793, -4219, -1109, -3034, -4958, -1180, 3599, -2334, -4963, -4019, -2043, 3096, -1956, 1661, 996, -4002, -1534, 3945, 3135, 2379, 1288, -300, -4964, -1632, -4234, -2910, -929, 2011, 2117, -3518, -337, 1055, 2372, -4713, 3894, 920, 2345, -3549, -1542, -4480, -3869, -3612, 4330, -4809, 4533, 4041, 1186, 2156, 3752, 84, 3338, -1523, 111, 4192, 4579, -118, 3112, 2624, -2511, -3233, -1497, 983, -4190, -3116, 595, -4895, -4725, 451, -2897, 4314, 4936, 948, -1168, 2381, 340, 2253, -3749, 303, 332, -605, 666, -2436, 672, 2658, 1313, -1024, 339, -3111, 4508, -3887, -2880, 4402, 3573, 2339, 793, 4307, 2686, 4226, -1140, -2320, -4400, -1410, -2748, 749, -3611, 2569, 28, 22, 2330, -830, -2487, 3202, -3716, -996, -856, -962, -2754, 1488, 2328, 4753, 2292, -1120, -475, -1130, -3855, 1903, -3374, -2502, -518, -1155, 3458, -32, 4867, -3112, 50, 3623, -1720, 2761, -4960, -2244, -738, -853, 3941, 4742, 2358, -1669, 232, -4637, 4987, 3611, 3957, -1060, 3337, -955, 3016, 4962, -4037, -2781, 3047, -37, 4291, -799, -4944, 3221, -99, 3744, 3954, -1658, 1726, -1501, -463, -3196, 4149, 3807, -442, -612, -2906, -4729, -1615, 317, -1065, 244, -1601, 2125, 3571, -455, -2071, -4997, -4342, -2764, 1386, -1223, -2206, -3663, 2474, 1600, 2015, -3787, -4032, 4287, 2517, 3908, 1542, -4213, -3131, 1872, -4135, 2144, 3963, -3135, 4420, -1351, -3282, 4741, -1879, 103, 4416, 2979, 3393, -2120, 1172, 2181, -3664, -4244, 1251, -3940, -4194, -877, -4783, -1891, -3391, 1324, -1043, -3012, 2096, -1587, -1937, -375, -3866, -4195, 1834, -3322, -1968, -539, -4431, 2688, 4413, -1600, -3706, -1055, 4448, 3115, 4344, 2454, 3805, -2035, -379, 1711, 787, -805, -233, -1510, 3475, 2790, 4463, -3, -2278, 4233, -3890, 4926, 1824, -1254, 4887, -2273, 4004, 1742, 1531, 1948, 1252, 193, 2143, -611, -3021, -1329, 3840, 4490, -1199, -3032, 1276, -2544, 675, -2760, -125, 3361, 3105, -3819, -4938, 3418, -3625, -3113, 1781, -2522, -202, -1764, 3320, 1441, -2290, -2350, -4152, 1493, -1150, -3409, -186, -2306, -4764, 4258, -3481, -1156, -3891, -1437, -4432, 3714, -2693, 3622, -2083, 1395, -609, 3176, -1299, 8, 4897, -3449, 2431, 2869, -1880, -2063, -1165, -3951, 3777, 3487, 3454, -3543, 718, 2552, 2395, 1001, 3828, -263, 2033, 1952, -4519, -4652, -3987, -2458, -554, 3445, -3422, 3695, 2289, 3029, 3064, 3206, 766, 1671, 1631, 467, 30, 206, 3313, 1825, 1923, -264, 4618, 3203, -4911, -71, 4381, -2379, -4476, 3792, -4098, -1092, 311, 3406, 1886, 3239, -2121, 499, -3309, 34, 1564, -589, 3929, -505, -4092, -594, 1705, 429, 2841, -3371, 2297, -1588, 1887, -2863, 648, -3065, 4305, 4967, -2098, -1924, 2455, -3949, 3590, -4142, 2550, 4255, 14, 3153, 2767, -2861, -2584, -218, 147, -26, 173, -1644, -1679, 4968, -1100, 605, 519, 4568, 2721, -4434, -593, 4034, -942, 4651, -3750, -4448, -837, 3861, 4656, -4458, 682, 2751, -1738, 459, -1518, 1043, 2870, 2463, 4232, -958, 568, -881, -2999, 3593, 1314, 4462, -1017, -4171, 2506, 3788, 162, -676, 2889, 1198, -4529, 3252, 4585, -2589, -1788, -3463, 1681, -389, 4928, 4412, -1820, 2804, 4958, 4721, 1516, 415, 4438, 2825, -4664, 2599, 1750, 49, -1458, 161, -931, -321, -3606, 2912, 2909, 3577, 4991, -11, -4845, 4422, 2701, -2660, 3484, -1744, -4136, 2702, 3217, 642, -311, -4145, 2988, -4860, -4986, -4910, -429, 2462, 4851, 521, -3557, -851, 2361, 3386, 4112, -2167, -326, -3417, -1865, 4964, -244, 4827, 2377, -2321, -1052, -575, 851, 3729, -2024, -484, 1362, 2553, -1818, -3066, 4607, 2541, 691, 3133, -4302, -2657, -2603, -58, 2993, 4140, -2127, 1641, 1148, 4051, 1842, 3956, -1554, 3711, 2139, 3480, -4397, -3717, 2401, -4838, -4374, 2852, -4774, -2353, 2067, 458, 2884, -1377, 3701, 503, -103, 1578, -1979, -3306, -1694, 1841, -3044, -3723, -1393, 563, -3294, -3853, 853, 1294, -3396, -2573, -3198, -1067, -4835, 610, 3720, 885, -2831, 3927, 3857, -4889, -4239, 3529, 2508, -2828, -4742, 839, 1979, 545, 134, 4325, 532, 3547, -1809, 2359, -355, -4454, 1128, -1646, 4062, 2948, 3501, 2505, -4264, 3843, 1496, 2473, 1866, -1116, -3668, 47, -702, -1898, -3097, 1601, -2955, 1090, 1015, 2092, 1193, -1721, -986, -2034, -3073, 398, -4710, 859, 1069, 3183, -3628, -2692, -788, -3734, 4509, 3814, -1495, -1629, 3998, 2760, -3725, -3582, -2959, -2061, -2027, 426, 729, -2872, 3481, 4815, 578, 3539, -1340, -3043, 3508, 1668, 2913, -1890, -2138, -1914, 2644, -4413, 1444, -814, 117, 4591, 2059, 4661, -4629, -4172, -4639, -1967, 2429, -1611, 4898, 3439, 4948, -157, 1207, 3968, 4246, 1753, 1976, -4155, 3594, -891, -3159, -1526, 1849, -4352, 443, -167, 201, 3739, -3701, 1527, 1019, -4867, 1300, -4590, -1608, -1426, 330, 1139, -2145, 2048, -807, 1057, 2169, -3125, -2501, 1398, 3051, 4886, -4855, 2305, 1674, 4017, -1077, -1699, -3060, -791, -3085, 574, -3733, -4301, -3484, 1241, 3669, -2457, -3578, 3562, 4107, -533, 3388, -4417, -1253, 3734, -560, -835, 883, -1488, -906, -2707, -2611, 58, 3492, -831, -2942, -3353, 4999, 4185, 397, 3131, 3121, 2652, 2232, 1080, 4624, -1772, 4889, 2327, -471, -4263, -889, 1951, 155, -3326, 3646, -1673, 2057, 2132, 2153, 1965, -1131, 1489, -3547, 2150, -2606, -313, -1851, -4106, -1594, -4493, 4535, 878, -340, -4862, -2370, -1035, 4200, -4623, 4854, 4711, 753, 933, 1570, -2149, -10, 927, 3755, 4104, -978, -331, 383, 657, -1867, 2513, 2068, 4268, 4973, -5, -943, -4594, -2994, -4156, -2924, 1462, 4451, 4293, -4316, 3521, -1826, -2570, -53, 119, -2220, 6, -4441, 820, 2283, 3546, 3054, 3731, 3448, -3854, -859, 3375, 4006, -3789, -2482, 3680, 2145, -4159, -2062, 2490, -1603, -3916, 3745, -1726, -4050, 3639, -2839, 3864, 2932, -4095, 1900, -1030, -3631, -4653, 3980, 575, -1706, 2451, -349, 273, -2896, 952, 2453, 1946, 2450, 4162, 39, 2820, 613, 1572, -3042, -2028, 4121, -4853, 2559, -4567, -2642, 51, -1382, -3045, -3119, 4167, -4915, -2506, 1454, -3567, -418, -1252, -166, -1493, -488, 2230, 3672, -1332, -887, 3708, 530, 4573, -1900, 3698, 2346, 4264, 1839, -4486, -2488, 191, 3382, 2533, 1340, 280, 1008, 3025, -525, -1027, 3288, -3617, -3203, -357, 3000, 4578, 1173, 389, -3812, -3835, 3452, 1981, -138, 692, 3769, -1187, -3783, 3648, 4792, 2024, -2710, 3893, 3898, 2307, -1056, -2229, -3226, 15, 1149, -2146, -2301, 3924, 3710, 4820, -3682, 1865, -3756, 3899, 4384, 3161, 3808, -222, 3503, 1999, -2672, 2963, -1687, 2558, -2817, 3471, -305, 4099, -2638, 4895, -4174, -4677, 3563, -336, -133, 2746, 224, -2104, 3416, -3162, 1030, -4196, -2001, 3820, -4866, 4257, -2245, 2499, -3746, -190, -3234, 559, -3739, 1402, 2062, -1368, -1822, 1506, 4880, -2417, 222, 1904, 4900, -4065, -4751, 3526, 4277, -2464, 2992, 1608, 4398, 955, 3110, -1856, 1328, 2955, 1373, -4292, -2746, -2787, 1783, 1525, 359, 1523, 4102, 2676, 1838, -4183, 1103, 3281, -1304, 1303, 1571, 1779, 1959, -680, 3404, 1370, -490, 2968, 4161, 533, -4874, -3681, 2090, -1942, 479, 396, 1115, -3099, -1170, 1922, -4984, -1206, -647, -4274, 1969, -1709, 2803, -2460, -4955, -3459, -1452, 4318, 2891, 2322, -1494, -586, -3279, 1739, -4491, 362, -3643, -712, -254, -3244, 2859, -1238, 3638, -209, -4285, -2017, 4072, 3619, -4740, 774, 1426, -1985, -2294, 4695, 81, -3342, -686, -4462, -294, -4163, 967, -132, -4208, 2698, -1318, -1729, 3218, 2365, 4447, 3325, -1655, -3118, 3560, 1957, 612, 4469, -4038, 3518, 757, 875, 3511, -4880, -3400, 2369, 3250, -725, 3262, 2929, 4761, -1931, -3333, -3502, -784, -332, 4380, 3964, 2460, -4350, -3647, 4353, -2601, 4242, -4893, 1673, -4650, -2665, -2302, 2523, -4484, 2579, 1089, -4916, -2725, -1921, -3154, -4949, -2025, 1335, 1222, -2527, 1651, 1562, 4953, 1590, 3728, 1011, 2082, 2244, -1662, -2163, 1667, 1907, -8, -4087, -1566, -3070, 1814, 3473, -3140, -136, -3811, 1387, -1622, 4840, 4472, -3081, 1698, -2067, -4113, -3287, -4925, 2733, -2356, -260, 2216, 3707, 275, 52, -1482, -2156, 3556, 4940, -1884, 3045, -2518, -43, 1372, 4998, 4164, -826, 2667, 2583, -2216, 4862, -3983, -1800, 3911, -4968, -1070, 827, -3828, 2380, 1624, -1314, -4121, 4466, -991, 3955, -2797, 1582, 32, 2600, -792, 1084, 3139, -2599, -4530, -1442, -2351, -3821, -2767, 2142, -1965, -4953, -1759, 4978, 1151, 87, -4384, -4388, -1240, 596, 335, -4112, -458, 2931, -607, 154, -1296, -4998, -2103, 2755, 249, 3158, 1989, 3790, -1286, -62, 1782, -3270, 177, -2538, -687, -1617, 3314, 3366, 1356, -4101, -2504, 1636, -990, -374, 3124, -4553, 1430, 1973, 1219, 1188, 2827, -1881, -1462, -1076, -4842, -3971, -4882, 3835, 899, -4827, 3832, 2782, -1757, 4323, -3476, 3542, -4026, 966, -1137, 1602, 2238, 4963, -1321, 4341, -3277, 1270, 529, 2334, 4580, -3334, 3944, 868, -4711, -3228, -2555, 1017, 886, 3423, 581, -4791, -2643, -1063, 1868, -901, -223, -2469, 1390, 1107, -164, -4071, -493, 3510, 740, 818, 2683, 3517, -3898, 4709, 4454, 4444, -2032, -3031, -106, -3129, 4315, 1718, -3712, 1049, 2404, 2416, -1815, -4747, 2741, -1583, 4529, -102, 1520, 3049, 3585, 4703, 4031, -4257, -2820, -3868, 4785, -3605, -2791, -1364, -2859, -491, -1492, -2008, 2514, 1093, 213, -470, 628, 4256, -1088, -1889, -4806, 453, -4243, -2396, -3471, -1069, 981, 1928, -320, 1431, -46, -1026, 755, -3500, -781, 4846, 2897, 756, -711, -4921, 125, -821, -920, -2575, 2266, -310, 4532, -3669, 3624, 4720, -1453, -2608, -2013, -2885, -4031, 4970, -4291, -1916, -2338, -3785, 4254, -1748, -4796, -4200, 313, -1983, 245, 2419, 1659, -4790, -1144, 1757, -4258, 3982, 3586, -3960, -3713, -3152, -3040, 741, 3891, -3025, -1777, 765, 1412, -1562, 130, -1367, -4649, -3295, -4287, -3018, 3260, -2233, -3468, -345, -553, -3931, 3588, -4510, -3825, -3699, 4583, 1102, 4893, -3674, -3212, -3214, 4309, -2517, -3406, 978, -1326, -3727, 4925, 1732, 4230, 509, -3211, 4500, -4165, -235, -2178, 1486, 3390, 4641, 100, 2363, -1964, 1702, 113, -1229, -476, 4250, -4897, -2215, -4627, 4737, 4844, 2811, 133, -4622, 4392, 4213, 2952, 4245, 1197, -1940, 1998, -19, -4752, -1754, -2940, -4656, -4341, 3780, -4206, -4814, -1302, -113, -2721, 27, 1478, 1129, 2409, -2318, 2562, -767, -2712, -3492, -290, -4290, 3059, -4353, -4750, 283, -3008, -2723, -4632, 4907, -4394, 4071, -439, 2999, 4604, -4943, -123, 3271, 508, -3609, -755, -3404, -610, 4131, 1341, 4379, 1628, -946, -4531, -2065, 3272, -822, -1019, 1906, 4916, 4313, -699, 2832, -1546, -874, 732, 2911, 3106, 2118, 3344, -1324, -4117, -4914, -732, 3803, -2227, 2717, 1423, 4835, 511, -3147, 3705, 2257, -2639, -3175, -2562, 3274, 1798, -1334, 3524, -3729, 3453, -1398, 4132, -4930, -2070, -739, -1688, -1255, 3842, -1392, 2784, 2086, 3046, -3117, 4727, -1543, -2674, 2980, 1035, 4588, -3661, -4957, -2733, -2466, 4539, 4883, 4572, 1937, -4351, -322, 3425, -3426, 92, 2442, 2246, -3307, 1799, -1370, 2787, -1483, -3087, -4231, 3353, 1577, 3903, -1338, 1845, -4736, -2402, -1172, -1904, 474, -2281, 667, -427, -2558, -2427, -485, -1053, 1421, -817, 4957, -1181, -1504, 2268, -259, -1333, 2985, 2570, -4418, -3584, -261, 1670, -2524, 328, 3426, 2072, -3076, -3503, -3896, 2344, 623, -1102, 4952, -1147, -2187, 75, 2728, -4030, -1247, -1853, -449, -624, -1736, 1150, -2981, 1465, -2326, -2966, 2548, -212, -1995, -3439, -422, 4630, -224, 2260, 2418, -2992, -1711, 810, -107, 3225, 4713, -1727, -875, -4635, 3200, 4435, -4405, -2887, 3614, -768, 1056, -2170, -39, -3910, -3959, -4950, 2568, 2801, 2392, -270, -4815, 2819, -52, -3153, 4193, -3946, -2780, -2969, 4368, -4061, -1915, 4252, 683, 2890, 3758, 1280, -1241, -175, -3352, 4321, -2520, 36, -1423, 3191, -2581, 2014, 537, -3229, -1539, 1377, 1510, -4573, -3377, 1113, -883, -4966, -1292, 3248, -1192, 1187, 112, -2073, 4406, 4946, 3935, -2811, -893, -3399, -4147, 1639, -3475, 999, 590, -1496, -2152, 2055, -952, 4650, -2343, 4802, -3402, 1347, -1763, -1525, 2182, 3422, -3884, 4075, -3857, -1074, -366, -1893, 3750, 1170, 3630, -4246, -2118, 841, 3041, -2089, -2473, -2727, 1181, 4951, -3036, 2426, 3094, -4129, 3990, -1686, 3466, 395, -2869, 4458, 4092, 3188, 4518, 2042, -2026, -3009, -563, -1491, 2316, -1912, 4371, -2189, 2680, 861, -3563, -2514, -2446, -4621, 3916, -1006, -2830, -1112, 1960, -3802, -4671, -277, -2543, -2255, -2774, -4971, -2889, -4185, -4010, 1913, 2740, -4469, 3282, -129, -880, -3515, -2751, 780, -1728, 4441, 4730, -3055, -1405, -1829, 1920, 1204, -867, -1663, -1221, -384, 1505, 3918, -1874, -4297, -3687, 1646, 4725, 4717, 4151, 2797, 1919, -3022, 422, -1509, -4873, 2284, 3565, 4982, 2534, 1263, -3310, -2978, 1077, 2737, 4450, -1558, -3644, 2525, -4714, 4567, -2341, 4088, 3075, -1899, -4187, 3360, -4865, 333, 164, -1531, 1353, 1376, 1183, 2471, -61, -2954, 3816, 291, 1127, 2468, -1465, 2905, 3061, 1501, -1627, -3273, -3217, -602, -4869, 1176, 3467, -391, 1038, -425, -4922, 2070, -1145, 3971, -414, 992, 234, -2130, -2899, -4255, 4496, 431, 2730, -543, -3048, 2566, 1436, 2212, -1209, -3376, 3813, -4346, -1203, -4248, -1952, 1042, -3708, 2883, 3189, -2930, -705, 1310, -4885, -3533, 4882, 247, -4603, 4714, -1313, -3620, -641, 1411, 2836, -4769, 2914, -2484, 3015, 4891, 4036, 2748, 3934, -1018, -4811, 4775, 72, -4430, -740, -969, 2458, 1062, 4913, 1246, -770, -1409, -2893, -465, 2421, 1133, -1419, -3380, 1850, -1827, 4146, -2988, -3389, 1388, -3939, 1354, -789, 1532, -3879, -848, 4515, 1566, -3770, 1351, 2671, 589, -3272, 2837, -3540, 3227, 2034, -4907, -2586, 1690, -664, 1509, 4619, -2706, 233, -733, -1513, 3035, -3303, 584, 1956, -4630, -652, 4934, -1651, -469, -1832, -1953, -4337, 252, 2434, 2422, -3711, 2753, -4952, 2337, -3379, 523, -3312, 2247, 1308, -3834, 3244, 2060, 4814, 494, -3291, -3993, -1415, -2761, -3003, -2117, 4663, 271, -1386, -604, -466, -3392, -4438, -2719, -4775, -4507, -1988, -4130, -2850, 3874, 3044, -1234, 2255, 4025, -4980, 2198, -2018, 3476, -4722, -4762, 4114, -3642, 4875, -1149, 3078, -1136, 1678, -3029, -3015, 1933, -3865, -2565, 4905, 2694, -3083, 1145, -2058, -431, 1317, 838, -2663, 3300, 1379, -3689, -3305, 4382, 3654, -1540, 2834, 4452, -2210, 4331, 2983, 4316, 4679, 3635, 4576, -2576, -419, -2404, 2170, -4224, -1315, -274, 770, -4305, 2217, -448, -3570, -4160, 1610, 1507, -188, 2049, -771, 2962, 3130, 3620, -1755, -3517, -4336, 2504, -2274, 961, -1703, 3795, -3107, 3286, -65, 1752, 3036, -613, -178, 3364, -3627, 834, -3658, -4581, 4365, -3792, 4467, -3679, -3477, -4225, -4162, 1573, 4044, 2796, -503, -2745, -4819, 381, 1851, 516, -2890, 4145, -432, 1168, 2563, 78, -1396, 3589, -3598, -1123, -3430, -4563, -4995, -3522, 2664, 1728, 1012, -1230, -4780, 2731, -1444, 1853, -2382, 2785, 3804, -769, -3932, 1154, 2991, -3493, 4024, 2629, 629, 417, -2368, 4480, -911, -3100, 806, -4202, -2339, 2765, 165, -2673, 2549, 2160, -2834, 4491, -3339, -3655, -2433, -4108, 3134, -2976, 3340, -4254, -1612, 2565, -2312, 1912, -444, 4740, -1007, -1375, -3225, -187, -4871, -2298, 4759, -2364, 2611, 3882, 680, 2335, 1500, 964, 3579, 3841, 1337, 3773, -1841, -93, 3869, -339, -4335, 626, 562, -1089, 4106, 2974, -2335, 3346, -2846, 3566, 4853, 2250, -1783, 1075, -1590, 1591, -3341, 3367, -658, -4967, 2900, 3591, 3447, 4538, -1643, -667, -2091, 2863, -4562, -1397, -1647, 4144, -2650, 382, 4659, 1083, 4211, -1433, 3144, 4166, 4899, 4864, -4763, 121, -924, -1347, 631, 95, 1239, 3613, 1743, 4415, -3764, -2039, -4395, 542, 4061, 3855, 3309, -2813, -1003, 4239, 916, 4182, -3072, -3366, 4095, 1612, 528, 4606, 204, -4730, -2704, 4221, -4407, 3326, -4521, 3066, -1143, -3313, -4399, -3156, 3460, -4306, 748, 325, -2983, -1361, 645, 2554, -60, 1557, 3294, -3775, -1194, -4661, 4343, -628, 3520, -2169, 822, -3558, -4697, 4930, 2110, -4481, -4617, -1776, -3077, -262, -984, 524, -4972, -3841, 1275, 3401, 408, -2386, 2903, -3846, 420, -4205, -3293, -916, -278, -1486, -1528, -1917, 3420, 891, -4466, -3529, 706, -6, 3862, -1118, 2394, -3004, 828, 500, 3117, -2284, -3514, -4333, -4203, -3610, 2538, 2593, 3531, -873, 949, -4709, -632, -4965, -3050, -1767, 4866, 4910, 2234, -2441, 4787, 1039, -3357, 1949, 1833, 2300, -3619, 3397, -3965, 4739, -4396, 3414, 1727, 4446, 587, 2371, 826, 3900, 4678, -1103, 3960, 263, 4639, 1167, -2330, -3893, -1896, 3392, -4463, -2336, 2848, -2722, 4433, 2930, -731, -2126, -4046, 2100, -640, 869, -900, 2614, -4625, -4847, -659, 7, 790, 821, 1004, -1350, -3636, -119, 4924, 1658, 407, -416, -657, -4447, 4169, 3686, 2661, -4523, -4669, -140, -2531, 4653, -2876, 1938, -2971, -1806, -949, 3065, -2497, -2383, 3740, 969, -4470, 2821, -2758, -146, 379, 3443, 4791, 2025, -4017, -2649, 3399, -4056, 3385, -2568, -1654, 3463, 3949, -4682, -3267, 3351, 1791, 988, 2685, 364, 1788, -4532, -1733, 3305, -1049, -2389, -763, 4506, -3848, 3185, 3155, 2146, -2989, -1732, -2877, -4261, 4786, -585, -1741, -3026, 4039, 289, -4078, -2387, 3289, 3224, -1698, 2734, 3733, 3270, 3088, 470, 550, 3901, -572, -365, 3867, 4163, -2964, -3710, -3778, -2909, 2663, -2253, 4427, 324, 2572, 1816, 1448, -4547, -3997, -2474, -2217, 3432, 4708, -3469, -1638, -1969, -852, -3885, 3730, 2933, -1563, 1498, 469, 1754, -487, 2783, 3149, 1695, 3477, -2515, -1801, -2490, -4676, 3742, -1609, -358, -4527, 4975, 4158, 3193, 1439, -498, 1364, 560, 3996, -3241, -4856, -2841, -3996, 1759, 1813, 2636, 914, 4556, -621, 1954, 843, -673, 2406, 3042, 3295, -785, -933, -2357, -2333, 1135, -3510, -4015, 2177, 1805, 4035, -1242, 108, -2124, 1543, -143, -1282, 4673, -4331, -1037, -695, -1723, -3453, -4979, -3796, -1010, -2421, -1295, -1718, -1506, 237, 4007, -1502, 2040, -1360, 3844, -3755, -3019, 2173, 1494, -669, -4251, -1339, -1846, -737, 4839, -758, -2362, 116, 4735, -1704, 4468, 993, -4382, -4932, 614, 437, 3984, 1878, -4218, 3772, -2195, -2552, -291, -1245, 592, 122, 4429, -3405, -4988, 2089, -388, 4779, -863, 145, 2270, 4023, 2984, -48, -4818, -4583, -1993, -1592, 2716, -189, -2052, 3187, 3419, 2620, 1528, 4355, -2539, 4425, -1285, 4657, 138, -3186, -3269, -661, 1357, -4216, 1480, -2618, 835, 1811, -2259, -751, 404, 1238, -532, -4241, 987, -3684, -4726, 1626, 2915, 4375, 720, -1512, -147, 4855, -3368, -4356, 2074, -2500, -1977, -832, 2035, 228, 1298, -4896, -2462, -2491, -1591, -2372, 1544, 905, -2916, 55, -4598, 305, -2818, -2448, 2312, 984, -4068, -364, -2355, -3325, -4836, -3385, 4298, -3705, -1068, 4626, 4941, 4387, -4575, -3259, 1953, -3513, 35, -4450, 4066, 2754, 3925, 80, 3243, -3354, -20, 4505, 490, 3222, -219, -1033, 2567, -3071, -2987, 1350, -4133, -348, 1458, 3667, 4935, 90, 3724, -2081, 1846, -2857, -3276, 3519, 954, -3925, 44, -3258, 1914, 4634, 361, -1224, -1552, -2726, -2646, 2853, 4832, 1526, -2471, 1988, -4451, 3721, -9, 4135, 4179, 1438, 2758, -3988, 5000, 3852, 1503, -2837, 900, 4459, 1162, 697, 3087, -981, -3546, -2390, -995, -1765, -743, 309, -1597, 3331, -3349, 225, -794, 2703, -4939, 2315, 671, -2223, -1745, -2280, -255, -163, -932, 2960, 3103, -1289, -2419, 1233, -1771, 3109, 3782, -4426, -1932, -4070, -1257, 4784, 809, -983, 3424, -1585, -4288, 4921, -4691, 2240, -3888, 2493, -4467, 4306, -3419, 2412, -3799, -1564, 2023, 1393, 4308, -4282, -2439, 4843, 3173, 3354, -4954, -1378, -4054, -1747, -193, 4675, -76, -467, -3602, 608, -1929, -1225, 357, -4421, -1787, 937, 1856, 3277, -4273, -4593, 1786, 497, 823, 3912, -2557, 579, 105, -4833, -2090, -4368, -2591, 3959, -1978, -1308, 4419, -4105, -4120, -579, -2640, -1577, -2394, -3806, 1725, -683, -4690, -3831, 1134, -30, -4877, -4698, 3089, -3829, 140, -4716, -1287, 2195, 2028, 2320, -1457, -2476, 2660, 4134, -2802, -3559, 2582, 3833, 4570, -4487, 1594, -1096, 1365, 2302, -3930, 2051, 712, 2921, 256, -1844, 3981, 4012, -2634, -2266, -3795, 1334, -508, -1872, 3657, 3450, -1473, -4572, 2415, 4878, -1431, -2875, 4320, -2664, 572, 2597, -3478, 4912, 2774, -1151, 1192, 3444, 636, -1664, 4632, -4005, 1256, -2161, 2314, -3150, 1911, 2651, -4804, 2224, -3231, 4640, -806, -4820, -693, 836, 2494, 552, 487, 1452, 2594, -4540, 4803, -3238, -1300, 481, -424, 2417, 4517, -2250, -1399, 3917, -1272, 832, -4577, 166, 1274, 2697, 2496, -4390, 919, -1876, 4292, -128, -23, -370, -1371, -1200, 1761, 2252, 617, -2609, 4933, -1828, -2047, -464, 2384, 2791, -4992, -2400, 2332, -798, 334, -144, -4793, -4314, 2528, -677, 4180, -3133, 3806, -4041, 1766, -872, -4645, -670, 4901, 4995, -2623, 3887, -1571, 301, -3174, 2403, 1565, 4551, -3575, -2670, 3240, -2631, 327, 269, -1226, 2003, -2535, 507, 616, 1832, -1464, -4844, 2193, -1275, -4429, -2258, -3458, 735, 4599, 3582, -2493, 1848, 1479, -4320, -160, 3412, 2269, 3410, 3026, 4902, 4917, 2838, 1048, -4578, 4915, -3251, 2739, 786, -440, 2031, 3019, -3629, -4733, -937, -3462, 3552, 2546, -746, -1166, 2625, 2402, 2726, -3757, 829, 2736, -3979, 1598, -445, -4940, 789, 3975, 272, 1091, -3961, -4319, 1345, -333, 3516, -2246, 4685, 293, -1774, 2937, 3725, 2027, -3329, -1845, 1459, -3539, -2742, -2360, 348, -4948, 4705, -4596, 3421, 650, -1887, -4861, 4424, 4788, 1282, 1806, 2824, -1862, -2824, 627, 4026, 2036, 710, -2912, 2793, -447, -808, -3966, -3851, 230, 1522, 2888, 4294, 4053, 777, -4366, -3046, -4489, 414, -4518, -1472, 600, 4437, -3348, -1785, -2131, -2051, 1389, 1706, 744, 2771, -1944, -2141, 1971, 1396, 1392, 1320, -2168, 1897, -3838, -541, -4704, 677, 1707, -2191, -73, 2388, 4658, -4376, -4554, 4049, 4689, 1710, -4378, 4750, 1234, 434, 258, 2126, -2963, 1620, 1063, -588, -1692, -3296, -918, -4688, -1044, -4148, -2655, -1770, -3464, 630, -4555, 3352, 2103, -2115, 2581, 3997, 1632, 3318, -3088, 1980, 4477, 960, -3411, 493, -4981, 2331, 2287, -100, 3786, 1581, -1519, -519, 4475, 3693, -2133, 4337, -4252, 1378, 1888, -1417, -1955, -4985, 3398, 2598, -4694, 259, -122, 3377, 3751, -3223, 151, -316, 1748, -2319, 4284, 4301, 60, 2809, 4244, 386, 4410, 4499, -3176, -2378, 4377, 3709, 2750, -4857, 1209, -4104, -3408, -3935, 1142, 354, 3991, -1408, -913, 668, -356, 3942, -4355, 2275, 2064, 3783, -2134, 2370, -2188, 1471, -451, 2052, 2806, -1239, 319, -4786, 3766, 3118, 310, -2135, -2920, -796, 16, 3536, 3092, 2439, 1491, 3768, 603, -1202, 565, 3660, -2248, 4495, 410, -3519, -4064, -1029, 4262, 874, 3512, 1974, 4133, -3373, -4642, -239, -4363, 4235, -2998, -843, -4146, -4758, -4900, -2685, 2953, 1032, -1435, 2115, -2833, -2862, 2844, 4988, -980, 1085, 1943, -2914, -4795, -3128, -4456, 4346, 4797, -3110, 4525, -2354, 4643, 4865, -975, 4762, 109, -1639, 3818, -3084, -3407, 1050, 127, -3429, -3867, 23, 322, 4247, -540, -1793, -1480, -3403, -3742, -4848, 2633, 540, -3164, -4043, -3672, 461, -2019, 3681, 3303, -1792, -468, -2337, -91, -3613, -4293, 4611, -2316, -838, 2481, 4808, 4974, -2867, 4530, 4870, -4138, -3918, -3049, -4140, -2596, -297, -299, 3850, 188, 4084, -3144, 3342, -1251, 2311, -2771, -3542, -2036, 4601, 4326, 4022, -729, -1758, 3543, -1022, -2594, 1158, -1064, -596, 1451, 1179, 4187, -2207, -4515, 3462, -4901, 1229, 1213, -1443, 3642, 1592, 288, -1507, 3986, 3851, 2580, 3507, 4767, -2293, -1385, 2537, 4129, 2843, -3423, 4519, 2213, -329, 4582, -1098, -3810, -521, 223, -3937, 3509, -92, 1553, -4044, 761, -2510, -2311, -256, -1439, 4857, -4173, 2873, -3895, -2884, -2235, 4909, 1013, 1136, -3337, -3618, 1852, 464, 4554, 3802, 3157, -2059, -426, -1843, 4699, 4628, 168, -2915, 3962, 216, 2969, 10, 1052, 4980, -3675, -2651, -3897, -3360, 728, 2630, 215, 2507, -741, 3523, 4279, -2069, -4383, -2803, -4919, 183, -1215, 4502, 2855, -2200, -633, 962, -3860, 975, -3445, 2104, -1579, 4859, 2171, -4340, -4250, 2459, 3021, 2866, -2932, 465, -3864, 3627, 3892, 1399, 4010, -4232, 2367, 2875, -2147, 2556, -1243, -4881, 4778, -4271, 1291, 3764, 41, 1909, 3283, 1985, 3673, 1844, 1530, 4614, 1104, -243, 4172, -3161, 4286, 2986, 4749, 2607, 2279, 811, 3827, 4522, 4691, -483, -1082, -3268, 2501, 1567, 3210, -2548, 4238, -2492, -5000, -4035, -306, 2157, 3535, 2854, 651, 316, -373, 1630, -2904, 184, 1828, -4956, 4732, 1029, -1959, -2775, 880, -2540, 1747, 180, -197, -549, -371, -4543, -2299, -954, 504, 492, -3553, -3232, 3907, 4943, -2113, -2287, -1139, -2809, -1925, 940, 2123, 3932, -3286, -230, -2621, -2023, -227, 4376, -1938, 544, 1023, 1404, 3674, 1487, 4688, 4369, 4861, -1681, -2371, -4770, -381, 3159, -801, -1532, 1521, 3881, 4873, -3876, -4931, 4339, -472, 2413, 3688, -354, 4156, -2681, 26, 346, -1071, -2119, -2401, -3075, 2066, 717, -4018, -361, -2805, -1807, 1935, -1057, 800, 1059, -1134, 2449, 2732, 4642, 3079, 2940, -2190, 3413, -2151, 3411, -4797, -2080, 877, -4524, 4032, -1742, 2175, 221, -3741, 2081, -2701, -2064, 1307, 1194, -1394, -3769, -3240, 1476, -1373, 4228, -780, -3470, 1094, -3981, 1281, 3587, -1716, -170, -2532, 3810, 3580, -3903, 802, -4047, -3601, -1991, 219, 4201, -2148, -4756, -527, -2496, -4, -672, -1949, 4299, -1080, 1696, 794, -568, 2127, -4009, -437, -1945, -1633, -2666, -4659, -905, -1895, 4241, -4237, 447, 585, 4670, -4081, 1864, -3616, 1157, 3394, 1333, 4858, -3963, 808, -1291, 4476, -3255, 4697, -1989, -3922, 3515, 944, -2276, 236, -994, 278, -3074, -876, 1058, -3382, 1560, 1097, -577, 2222, -598, -1573, -2937, -4212, 3685, 70, 719, -3316, 42, 4773, 1397, 3172, 4285, -4619, 2251, -2717, -2499, -4465, 2747, -4636, 2389, -1999, -4322, -1595, -3142, -2911, 4976, 658, -3148, 4927, -2361, 3666, 3664, 4547, 557, 2526, 1622, 2990, 2141, 2725, 2709, -2917, 2512, 2007, -68, -4289, 20, -1197, 207, 1071, -115, 260, 475, 4407, 3379, 3056, 1405, -3880, 1768, -3886, 2185, -2944, -4435, 274, -3359, 3263, -309, -665, 4016, 2759, -1484, 1461, -511, -4020, -562, 3296, 2926, 1265, -4177, -3086, 4766, 3661, 819, 2936, -866, -1233, 452, 4373, -820, -90, -3700, 4600, -1025, 2858, -1533, 4094, 2649, 1686, 4718, 2299, 3280, -4546, 3349, 2452, 3696, -151, -1951, 2589, 768, 4436, -2757, -2635, 2673, 2941, -77, 1729, -1376, -4512, -169, 3548, 3537, -2084, -3058, 1205, -12, 1684, 4768, 3181, 4949, 3645, -4323, 4157, 4706, -3569, -1214, -3702, -3038, 1609, 2956, 2648, 1352, 4731, -2521, -2689, 4354, 372, -4072, -2209, -1817, 566, 4199, 801, 2666, 1348, 1060, 4068, -2923, -1216, -759, -1568, -4039, 2215, 3254, 2861, -4699, -4066, 2752, 4288, -3336, -4063, -3568, 1316, -1421, -3457, 156, 3836, 2180, 1108, -1478, 2744, -2046, 3082, -4989, 2982, -1262, 4154, -592, -3335, -3541, -1693, 721, -2676, -3526, -1260, -662, 3717, 943, 76, 3485, 3572, -3168, 2333, 2446, -4385, -2632, 1406, 1045, -1823, 1375, 1232, -2628, -4440, 4385, -1786, 884, -3690, 3298, -1146, 3774, -1256, 4799, -367, -1930, 2619, 713, -478, -4717, 1464, 4662, -674, 4819, 739, -2688, -4096, -4242, 123, 1665, -854, -231, -1819, 1512, -1565, 632, 3989, 3236, -2943, 662, -4211, 1737, 2469, -4899, 1146, 918, -1556, -1596, -2114, 4202, 2273, 3461, 3749, -989, 2849, 571, 403, -4935, -3573, 547, -2286, 4445, -3199, 4728, 607, -3947, 4014, -359, -574, -4674, -765, -1584, -4283, -748, 845, -3460, -591, 4093, -2519, 2957, -2801, 928, 3763, 2814, -1083, 2898, -376, -2461, -2974, 3276, -2271, -124, -1346, 2008, -2041, 2628, 2692, -775, 4629, 4996, 3323, 561, 40, -888, 1061, -3033, -4999, 3229, 1858, -2990, -293, 226, -3877, -1761, -4107, 1100, 1517, -2037, 1568, -4134, -2174, -524, -1536, -1273, 4748, -894, -1616, -3917, 4186, 3285, 1429, -3804, 4456, 3761, -723, 1415, 661, 1807, -709, -2415, -4437, 3826, 1770, -1380, -1369, -2230, 4646, 4712, -1751, 4806, -1086, 126, 308, -953, -3921, -385, -1446, 1360, -3572, 760, 2482, 1326, -228, 4956, -3249, -2429, -1079, 723, 2159, 2002, 2613, -2398, -4776, -2192, -1091, 2108, 2677, 3584, 4546, -104, -2600, 1384, 4710, -4449, -1471, -4358, 1524, -308, -1157, 3821, -1998, 2978, -2918, -4576, 2925, 2192, 4989, -1623, -2434, -3912, -2849, 2695, -4207, -4272, 1595, -3754, 3268, 2743, -1066, 4070, 3965, 3104, 4877, -2941, -3245, -1780, -2804, 1899, -2847, 1036, -452, -2016, 634, 2518, 264, 1984, 1826, -377, 971, 3906, -3753, 698, 676, -2505, -2770, 4042, 2362, 2555, -250, 2364, 4137, 2571, 3884, 813, -1962, 3736, -198, -4734, 4615, 2745, 1413, -1474, 82, -2626, -435, -3808, 4055, -1204, -3215, -4452, -421, -2736, 19, 694, 701, -1791, -4402, -548, -225, 2178, -3412, 106, -3861, -3768, -2687, 4524, 1925, -2919, 3465, -4086, -4393, -47, 4329, -2197, -1824, 922, -4832, -2641, 4796, -1391, -289, -1855, 2391, -2086, -3863, -1696, -4188, -2645, 1862, 1836, 4090, 4602, -2158, -2605, 2966, 4755, -2129, -3707, 1418, 4939, -3363, -764, 240, 3909, -3146, -3367, -347, 4414, 4923, 4206, 1795, -2241, -3685, 1569, -3943, -1996, -1193, -1610, 1121, 2054, -3398, -4702, 1983, -3281, 3033, 2248, -567, -2128, -750, -2842, -1175, -663, -2181, 2610, -961, 4565, 2258, 3321, -40, 2231, 312, -4683, -2630, -1835, -2996, -3985, -3358, -204, 746, 3297, -504, -3189, -2411, -276, -4221, -2171, -3102, 3495, -3242, 4993, 3438, 1537, -4631, -2283, -4060, 2954, 4722, 455, 2267, -1934, -3216, 4888, -2366, 345, 3952, 3858, 4553, 2938, -3511, 101, -4501, 1692, -2939, 2301, 4881, -2931, -804, -2561, 3213, -4085, -535, 2515, 1305, -3221, -3780, -1863, -2819, 2094, -879, -4040, 583, 3232, 4564, 1804, -296, -1923, 1893, 1780, 1455, -4506, 957, 932, -382, 3251, 4362, -3157, 157, 1772, -210, 546, -4559, 4965, -4816, -2947, -3688, 4087, 1877, 1319, 390, 4914, -4761, -1198, 3723, 4608, -3266, 4798, -4453, 355, 3920, -110, 1873, -3596, 2713, -3923, 2635, 197, -3285, 2047, 4542, -415, 3395, 4696, -3284, -2139, 4236, 1996, -176, -4765, -2100, -3608, 652, -4122, -1084, -993, -2838, -689, -3438, 4544, 1947, -4001, 689, -4317, 468, -4209, -4457, 3554, -547, 2723, 670, 2323, 846, 917, -1451, 1534, -248, 2904, 2950, 911, 3876, -965, 1588, -2553, 439, -2288, -457, 315, -369, 4821, 1296, -1530, -4318, 1401, -3622, -2479, 2626, -4686, -3455, -4839, -57, 945, -4509, 3522, 3037, -4479, 1383, -4275, -412, -1179, -757, 517, 1346, 941, -1730, 2071, -1734, 4493, -3905, 4276, -200, -3652, 3715, -4807, -4014, -1309, -925, 1082, 3856, 1095, -4073, 4543, -2853, -4721, -1061, 956, -4580, 4777, -4613, 784, -2546, -4300, -4864, -2173, 4498, -4076, -1762, -2827, 3137, -4773, -1775, -4360, -3693, 2039, -685, -2808, -4345, -1476, -4149, 3873, 460, -4372, 2689, 1975, 2149, -694, -1040, 441, -1336, -555, -319, -2533, 376, 1007, 2200, -1648, 282, -2275, -1095, 3905, 1884, -4570, 246, 4528, 3201, 2479, 1, 2437, -2926, 1529, -551, -2882, -3059, 3259, 2942, 1457, 1640, -2980, -3784, -408, -2616, -350, -303, 4698, 1773, 4715, -4197, 2826, -423, 3348, -2614, -3428, 9, -2397, -4969, -4735, 4259, -3659, 1970, 4008, 3245, -2224, -4380, 4531, 4085, 1427, 2678, 365, -1684, 1254, -1901, 4101, 1400, 3165, -1183, 2298, 1385, 1165, -4389, -3873, 1283, 1556, -544, 1576, -2700, -4118, -4993, -4513, -638, 4115, 3771, -4633, -3082, -3600, 3347, 1561, -2744, -2322, 1693, 4668, 2274, -727, 4231, 2296, 2947, -1849, 849, -4338, 262, 3171, 3022, 1724, 2399, 419, 2902, 733, 4194, -2095, -1013, -2454, -1182, 4220, 1349, 2121, 724, 302, -4903, 300, 4871, 2263, 599, 2349, 1087, 384, 1220, -2541, -59, -420, 1119, -2648, 371, 12, -3330, 2207, 1440, 1894, 3860, -3292, -1886, 804, -858, -1878, -3053, 1720, -1250, -3948, -1248, 1797, -403, 4758, -718, -2238, 935, 796, -3765, -203, 314, 374, 3583, 3718, 1637, 3779, 3409, -3813, -1674, 3671, -3299, -868, 1358, -2860, 1156, -184, -2020, -3614, 4274, -1974, 3474, -344, 896, -639, 3329, -517, -3506, 3756, -3850, -2566, 1079, 2693, -4720, -1479, -4760, 2211, -4377, 4595, -4526, 391, -3222, 615, 2882, 506, 1231, -1073, 3497, 707, 695, -1511, -2048, 3800, -1266, -2144, 1669, 1717, -839, 2079, -513, 3308, 4781, 3592, 4302, -786, -1353, 218, 3116, 1603, -3809, 2265, -1301, -4161, -4638, 4879, -3362, 254, -3321, 4372, -1294, 4417, -861, -520, -4153, -3078, -4574, -3635, 4869, -4614, -159, 2282, -1607, -4329, 522, 1477, 203, 1835, -600, 496, -486, 3690, -2529, -3434, -3509, -2895, -3300, 4489, 2158, 946, 3205, 1502, 3339, -1244, 3317, -4789, -2946, 856, 3699, 2038, -561, 4918, -1888, -606, -238, -3114, 3829, 3371, -1682, -4500, 3879, -1310, -4235, 776, -328, -2455, 4089, 4388, -2740, -3318, -3956, -1032, 3697, -1589, 1002, -3524, 4342, -4947, -4647, -1635, -4802, 2470, -742, -730, 2187, 2877, 1278, -3900, 3889, 2295, 4994, -3950, -66, -2730, -2620, 567, 3875, -1153, 3311, 1445, -2198, -4812, 2196, -1656, -542, 824, -3473, 1248, 2699, -4781, -3676, -2542, -3230, -79, 3936, 1201, -2205, -3498, -334, 199, -787, -2784, 505, 3428, -3127, 4290, -3425, -3365, 791, 3694, 1267, 1474, 45, -2228, -581, 2850, 3038, -4606, -2724, 3993, 4694, -1129, 2093, 1434, 120, -4178, 611, -273, 619, 4682, 3853, -4675, -4987, 1485, 297, 4836, 4170, 491, -1784, -710, 1589, -3781, 2896, 1323, -2516, 4566, -3603, -171, 2987, -2262, 2214, 4029, -782, -2814, 4938, -1939, 2063, 2851, -2922, 1325, 2338, 2935, -744, -3726, 4852, -2571, -2054, -2735, -4525, -1753, -3920, 3692, 1076, 4047, 4560, 1656, -734, 2727, 3080, 356, -4870, -4533, 261, 2382, -2101, 1292, -2234, 2430, -2031, -3698, -4808, 4581, -2399, -3204, -247, -3381, -2143, -4708, -1535, -3035, 1132, -3665, 1583, -684, -4497, 4266, 4961, 4391, -3207, 3568, 3538, -4894, 3948, -4249, 659, -1642, -2598, -1910, -1778, -1677, 1755, 1338, 4126, -2615, 663, -155, 2768, -368, 2485, 4813, -3433, -627, -4119, -840, -3777, -2728, 3287, -4021, 531, -4227, 4198, -4049, -2826, 1891, -2950, -4673, 3647, -800, -915, 3333, -4270, -509, 1495, -2392, 2245, -3818, -1927, 66, 1701, -400, -928, -2123, 4234, 4401, -2607, -191, 4765, 2578, 2016, 2764, 3607, -1460, -3210, 795, -417, 737, -2907, 428, -4592, 2981, -2003, 4081, 1380, -4933, -240, 2511, -4662, -4611, 1118, -3388, -1500, -1545, -2297, -3680, -2892, -3197, 2831, -1671, 773, 4077, 1689, 2078, 3415, 421, -3915, -2782, -1038, 1021, 3429, -4168, -2995, -4579, 495, 1422, -2597, -3805, 4405, 4001, -3092, -4868, -4404, 2672, 2587, -898, -1249, -3551, 3616, -2066, 1447, -4628, 3632, 284, -406, 3177, 3713, 1022, 598, -583, 1301, -753, 1414, -1499, -1877, 369, 1683, 3127, -2945, -2002, 3376, -3683, -3798, -2125, 4176, 1680, -985, 2376, -3583, -3902, 194, 401, -1162, -2226, 2632, 1416, -4858, -2243, 1470, -2332, -2277, 3151, 4152, 3212, 3086, -4534, -4127, -1058, -2592, 4664, 3083, -1961, -1782, -3495, 1763, 4986, -2868, -474, -481, -4890, 1433, -28, 83, 96, 3601, 2906, -3899, 3190, 186, 3847, -3235, -2667, 3837, 4801, 456, 2235, -4433, -3908, -2304, -3220, -1866, 725, 1676, 2828, 3017, 146, -1081, 906, 239, -696, 3482, 3160, 1611, 363, -1152, 3330, 2668, -1264, 3031, -2, -87, -2201, -1710, -4045, -907, -50, -1966, 734, -1271, -3013, 4501, 2823, 118, -3435, 171, -4739, -3696, -1700, 1160, -3089, 1550, -3942, 2735, 2871, -390, -2432, -98, 3636, -3171, 910, -2968, -3758, -4419, 3848, -2629, 292, -4589, -3187, 2168, -917, -4724, 1435, 752, -1348, 4054, 731, -1002, -1680, 2336, -1317, -3883, 3011, -2844, -1625, 4816, 424, 1915, -3697, -4294, 655, 1237, -4082, -1383, 406, 1719, 1147, 1137, -2447, 3640, -3817, -587, -2000, -18, -2444, 476, -3237, 4487, 4637, -450, -4139, -2622, -1429, -4612, 3670, -3136, -4749, 99, -3454, 3550, -3356, 844, -312, -617, 2972, 2500, -565, 4399, 227, -1186, -2957, 360, 3612, 4440, 1697, 2276, -3537, -3017, 972, 1765, 4838, 525, -629, -257, -3096, 1184, -3011, 2856, 580, 1273, -2087, -3027, -405, -1920, -4951, 2901, 1968, 2191, 192, -2407, -3091, 4950, -78, -3531, -172, -844, 24, 674, 3747, 4563, 2674, 1437, 1065, -3317, 3534, -2009, -2855, 889, -410, -3580, -3208, 2958, 1027, -446, 4282, -1569, -3289, -2743, -2268, -338, -266, 730, 4896, -441, -1941, -2085, 3039, -3944, 2970, -654, 2592, -2451, -72, 4020, -2384, -1218, -797, 951, 4807, -988, 4340, 1028, 3470, -4334, -1365, -2534, 3014, -3105, 2114, 4667, 286, 2236, -4328, -1005, 3195, -2763, 1226, -1854, 4091, 3163, -3051, 4513, 2001, -4929, -537, 4177, -1913, 4849, -4080, -3528, 1991, 3071, 4700, 1182, -4741, 1343, -3532, -3280, 747, 4681, -1524, -963, 1143, 1796, -137, 1644, -1407, 2590, -871, 3129, 4481, 4374, 1287, 743, -1078, 3350, 921, 803, -3803, -2377, 4253, 4214, 842, 4136, -4343, -2416, -692, 4677, 3126, 1870, 353, -4048, 3890, -1640, -4550, -3461, 2808, 2650, -4904, 3233, -2772, 2711, 4609, -2222, 1000, 1722, 248, -2870, 3609, -4422, 831, -2716, -4843, -4695, -1094, 153, -2810, -232, 268, -2900, -1659, -3057, -4670, 837, 1111, 3214, -3193, 3085, 3767, -3969, -576, -774, 4478, -3924, 3762, 4648, -4626, 936, -3875, 4474, -3565, 985, 633, -4926, -2508, 1966, 779, -4830, -2985, -4681, 2670, 484, 656, 1130, 3706, -2579, 1202, 4751, -44, 1837, 1424, -1986, 129, -3906, -2327, 2542, -201, -3432, -3856, 4203, -3487, -4132, 1355, -3418, 4204, -1469, 3868, -1503, -4551, -346, 3257, 3865, -2574, 3921, -3080, 3332, -1570, 1990, 4660, 358, -552, -4330, 3491, -4841, 3142, -857, 448, 4612, -3736, 412, 350, -363, -1159, -3052, -1440, 4514, 1666, 2656, 4383, -2478, -3984, 1758, 2781, 2309, -3646, -4268, -956, -2094, 4483, -3177, -2936, 4311, 1619, -3047, -4823, 3301, 1261, 1410, 2162, -1330, 1092, -1050, 4267, 2073, -870, 1224, 1789, 438, 879, -3657, -141, -4223, 848, 1443, -4053, -2739, -4164, -1943, 2622, -3320, 1709, -4654, 3457, -3782, -1641, 2794, -974, -3427, 2606, 501, -4186, 2547, 3581, -3414, -3840, 394, 3551, -2265, -1814, 4571, 2719, 1044, 1174, -4204, -1882, -221, 1657, 4473, 3261, -398, 3732, -4359, 2521, 2524, -3158, 1617, -3774, -4067, -1278, 4138, -1177, 2510, -1424, 2807, -3586, 953, 1277, -3016, -1490, -3139, -1358, 400, 220, -564, 2228, 1003, 2154, -4311, 2830, 865, 3204, 887, -4805, 4738, 3575, 2286, -3250, 702, -1873, 2885, -1555, -614, -1450, -2881, -161, -1548, 1293, 4345, -752, 3290, -4157, 2659, 2456, 4400, -4701, -4918, -4091, -1505, 4225, 4265, -1042, 1381, -38, -4566, 4423, 370, -4884, 1552, 3154, -1689, -4286, -1363, -2423, 2539, 2868, -482, -3448, 1977, 3459, -2219, -4103, 331, -4189, 4744, 2684, -2845, -3062, -908, 3168, 2435, -948, 4111, -3649, 4894, 267, -1760, -3441, -3536, -1161, -3149, 4363, -2741, -4854, 4098, 2862, 1009, 1987, 4460, 2712, -392, -4561, -1259, -56, 783, 2700, -4034, -4564, 3866, -208, -3315, -3246, -4238, 3335, 762, 3063, -4004, -1637, -2480, 2202, -992, -3928, 4997, -4660, 4592, -1919, 2531, 1541, -3977, 2662, 4197, 3834, -1715, -2871, -3994, 241, 2488, 2375, -397, 2310, -957, 1467, 4990, -3830, 4492, -557, 3197, -4504, -399, 4647, 3341, -2122, -2088, -2583, 3943, 4069, -2545, -3889, -2677, 2393, -2731, 4364, -2380, 2573, 1634, -619, 3478, -736, -1604, 4782, 1688, 862, -3194, 2881, 4065, 1892, -1387, -4588, -926, 1259, -1960, 3430, 3316, -4256, 198, -183, 895, 2612, -2309, -3064, -1581, -1023, 736, -3472, -214, -4217, 1105, 4623, -4247, 1189, 77, -45, 5, 4359, 4281, -3496, 1967, -885, -2305, 4395, 2261, -150, -2180, 3976, -4482, 1662, -2414, -4445, -4798, -4584, -281, -1756, 2083, -3730, 2867, 4046, -4970, -3224, -3170, 3436, 4057, -4685, -298, 860, 4842, -1740, 3910, -2929, 3156, 423, 4332, -3874, -2232, 1774, -4604, -2729, 2119, -2193, -3990, 170, 4645, -967, -1459, -4696, 2147, -2325, -4705, -3446, 1810, -3648, -4787, 4527, 833, -4461, -3849, 250, 3999, 3830, 3235, -636, -4872, -4310, -1779, 3178, -3974, 2397, -4772, 295, -2475, -3992, -1359, 1584, 4747, -1122, 2928, 2010, 687, -4006, 2762, 3703, 3440, -3093, -3191, -1366, 986, 2530, -4996, -1327, 4171, 2675, -2470, 1605, 2608, -1997, 624, 807, -4260, -2779, -1574, -4651, -3653, 1648, -1606, 2777, 2604, -2902, -1344, -4851, 102, -2550, -4687, -2264, 2876, 1731, 2044, 551, -3926, 3778, -1045, -4126, -3911, 3018, 4984, 482, -1046, 2306, -3641, -1447, -2164, 4520, -3192, 1053, 4757, 2919, -3302, 4983, 2225, 2778, -1722, -3467, -4528, -4151, -2453, 1420, -1769, 597, 3060, -4902, -2295, 2122, -292, -2406, -24, -1323, 1859, 1896, 812, -938, 3870, 3506, 3027, 2788, -88, -1269, -4898, -4535, 514, 1548, 1821, 1152, 2461, -4201, 4769, -1401, -1434, 4504, -1675, 1672, -1059, -507, 2208, 2800, 902, 2109, 3068, 4603, 3741, -4058, -4116, -1598, -802, -2675, -1169, -653, 3787, -4879, 1790, -3195, 2495, 1067, -1279, 4119, 2290, -1355, 3102, 3753, -1714, -3488, 1647, -3936, 4159, 3147, 1902, 664, 158, -4012, 3496, -1117, -4003, 4078, 2872, -570, -4410, -86, 1918, -2242, -4490, 1101, 1533, -4568, 2477, 2603, -404, -2956, -4181, -3179, 2037, -4386, -3670, -2010, 2076, -841, -1870, 4335, -726, -1717, -3666, 553, -1958, -3440, 1802, -4601, -2038, -4748, -1957, -681, 2009, 1268, -1520, -1537, 2766, -413, -215, 399, -2044, -3843, -1948, 586, -1515, -1746, 3242, 4030, -213, -3638, -284, 1374, -245, 2, 366, 3653, 3532, -1928, 2860, -2256, -4878, 4826, -1834, -2485, 110, 1910, 3069, 2967, -3290, 1096, -2776, -4011, 3145, 665, 114, 4465, -2004, 2467, 2961, -1115, 2005, 4249, 3310, -4738, 4439, -1975, 4076, -3771, 4680, 4945, -1538, 968, 876, 2894, -3952, 3315, -1578, -3844, -33, -500, -3752, 2280, -3340, 3533, 144, 1098, -3257, 2087, 3132, 4597, 2411, -1812, 321, 4972, -1749, -778, -2076, 3368, 4616, -55, 1284, 4736, 4205, 1243, -1697, -323, -1414, 4559, 1963, -216, -934, 959, 323, -341, 4097, 2615, -3745, 3007, -892, -2440, 94, 4312, -4253, 2833, 62, -3823, -3264, -1549, -2459, -690, 775, 4590, -2610, -36, 4890, 4175, -217, 3655, -1210, -177, -2420, 647, 3815, -1062, -735, 3365, 4430, 974, 1831, 3055, 1191, 425, -4828, -1436, -1174, -1489, 1652, 344, 1614, -325, -4222, -4455, 3020, 3486, 2444, -2472, 2308, -4982, 738, 3781, -2403, 1169, -4055, -912, -526, -428, -85, 4734, -4312, -109, 2502, -2668, -97, 2878, 2527, 3987, 1618, 593, 1446, -3134, 1942, -1416, 1086, -977, 2233, -618, 781, 3373, -2786, 2509, -2111, 1992, -2422, 3141, 1972, 4280, -67, 1917, -3014, -4415, 3555, -2194, 2535, 1776, 1540, -865, 46, -550, -2494, -534, 763, 4251, 25, 1331, -4102, 1704, -1840, 135, 641, 3904, 4479, -1661, 4841, 3304, -795, 970, -1517, -2762, 3662, 2602, 2497, 3931, -70, -3814, -3577, -922, -1903, -1124, -2938, -4269, -3384, -2577, -1529, -3068, -4364, -4436, -719, -4607, 4947, -3933, -777, 3988, 214, -1176, 4752, -1561, 890, -3172, 3369, -3497, 3237, 4510, -1613, -1163, -3390, -3431, 4117, 3824, 2616, -3556, -2682, -380, -597, -2547, -3260, 3785, -4373, 73, -2162, -2249, 4537, -145, -3970, -2093, 3597, -3738, -1110, 715, 4906, 2172, -4840, -1810, 2091, -4905, 538, -1885, -2391, -4648, -4557, -2015, 2720, 1822, -1384, 2653, -538, -4689, 4218, -3637, 3799, 3306, -2006, 1535, 1508, -1475, 1216, -4759, 37, 402, -2359, -997, 2053, 3128, -3919, -644, 1855, 1164, -4537, -1051, 4304, -1670, -268, -2554, -4279, 4716, 554, -3728, 1736, 573, -2713, -2934, 3928, 2017, 54, 1536, 2840, 2206, -1750, -971, -2997, 2088, 4143, 3625, -2854, 3336, 873, -1201, 3651, 3383, -4737, 639, -4313, -2840, -2927, -1521, 643, 1784, 622, 167, 3576, 3319, 2669, 2304, -2560, -1790, 1051, 2910, -2498, -3319, 209, 2639, -4569, 1318, -625, -3343, -1352, -3103, 3983, -2285, -2176, 4549, -4837, -3007, -1816, 3186, 196, 4408, -2347, 1449, 1468, -3185, 2543, -1374, 2179, -2644, 3801, 4067, 3700, 139, 3933, 1460, -2753, 3246, -4794, -4886, -4924, -2765, 1863, 489, 1547, -285, 2551, -15, -3560, -3564, -3973, 4672, -2908, 2706, -4495, 3207, 1499, -1281, -1455, 1124, -1320, -930, 1650, 1342, 539, -49, 980, 3446, -1789, -2437, 1419, 3863, -2221, -2005, 3196, -501, -3002, 534, -4810, 699, 2722, -1307, -4817, -1185, -2715, 3540, -3709, 3759, -352, 2710, -2979, 3114, -4755, 3652, -253, -1470, -3247, -462, -3061, -4459, 3569, -2142, 1290, -3508, -4961, 1869, -3732, 4613, 393, -2905, -3862, 1190, 2949, -4824, 1046, -3263, 4824, -2525, 637, 782, -2953, 1808, 3012, 4548, 3358, -168, 2106, -2468, 726, -2033, -4615, -3737, 4743, 4404, 4911, 4818, -845, -2463, 913, -4362, 4040, -3283, 2770, 4011, -4767, 1366, 296, -3474, -1126, 4272, -3595, 1026, 4486, 4409, -1432, -283, -4974, -1267, 686, -514, -1357, -185, 2772, 279, 3378, 4860, -642, -1090, 3915, 2792, -850, -2202, 1249, -2435, 2691, -158, 1006, -2678, -1544, -1477, 3689, -1541, -2323, 1225, 3077, 1559, 2012, 2264, 1895, 3405, -4731, 3809, 4393, 3513, -834, 2503, 798, -4303, 2655, -2279, 2285, -3067, -3892, -4499, -3909, 3574, 1931, -2196, -1107, -2991, -3954, -886, 1738, -666, 870, 4195, 2188, 2387, -2913, 1638, -154, -776, 2585, 4847, -2625, -4110, -1773, -982, -3332, -1802, -1220, 1616, -4892, -438, 893, 3097, 4772, -96, -2627, -1328, -3562, 2325, 178, 179, -2012, 3008, -772, 601, 2595, -3615, -4560, -2231, 3564, 3427, -101, -1650, 3970, 2385, 3621, -2157, 2484, 4488, -3098, -252, 3878, 2277, -2204, 1829, 131, 3819, -3344, -811, 3953, 1161, -4803, 1800, 3525, 11, 3888, 888, 3219, 4929, 2965, -4245, 1332, 2124, -947, -701, 3776, 4123, -646, 3626, 958, -1902, -2883, 3374, -1404, 21, -4325, -2564, -2239, 997, -2866, -3415, 1716, 1469, 4497, -4220, -4672, 3148, -4052, 4746, 4960, -1261, 2939, -1950, 2704, 4610, -489, 4534, 4723, 2303, -1212, -479, -3662, -1039, -3151, 2321, 2294, -3527, -4460, -3465, 143, 2920, -2481, 947, 4471, 2997, 3073, -3766, 1200, -2260, 1321, 2176, -4401, -4684, -559, 337, 4922, 3845, -3178, -3878, -3763, 1803, 3683, 2373, 527, 660, -3719, -766, -2613, 1257, -4785, 1699, -480, 2348, -649, -1456, -1735, 2857, 4209, -179, -271, -1907, 3499, 1627, 2407, 3182, -1104, 2350, 751, 4113, 564, -2683, 1675, -2418, 2317, 3896, -2097, 4966, -3499, 243, 1206, 3211, -3964, -2958, 4884, 815, 2916, 1815, -1875, 1368, -4846, -3740, 2441, 2355, 445, -3351, -4745, -1652, -4379, -1207, 3479, -3145, 788, -2790, 536, -433, -4692, -324, 3488, 1016, 2357, 4621, -229, -3797, -4111, 548, -1021, -2580, -531, -2345, 3558, 1253, -3482, 1787, -1379, 1934, -3870, 29, -4552, -1316, 2101, -1293, 2631, 2839, -2732, -1683, -4876, 4850, -1422, 939, 696, 4208, 3702, 3293, -895, 4317, 2398, -4788, -4170, -1158, -3444, -714, 4494, 830, -372, 799, 4210, 3606, -4937, -1668, -3807, -3000, 1905, -1343, -3945, -4912, 1515, -82, -3720, -4472, -3852, 1227, 2887, 4919, 1961, -3592, 3292, -4522, 2886, 3995, -3927, -2056, -698, -855, -3274, -1413, 2520, -1461, 4652, 4598, -2697, -2160, 1901, -1560, 2443, -4505, 4196, 2148, 4805, -456, 1593, 1756, 3940, 1031, -3094, -3252, 942, 3048, -1372, -1111, -3169, 1606, -395, -3037, 471, 3004, -762, 33, -1705, -4128, 1682, 2112, 4108, 4370, -2612, 2347, 526, -142, 2813, 4367, 1110, 556, 4103, -4605, 2810, -2342, -3395, 1715, -2225, 4800, -3165, 850, 169, 950, -2272, -4028, -3776, -2738, -2055, 1955, -4488, 3967, 2557, -117, 4037, 4366, 57, -2150, -824, 4575, -4179, -2106, 3483, 4523, -3751, 2291, 3053, -2965, -75, -4602, 817, 1025, -162, 2209, -4169, -2329, 1927, 4243, 2641, -1712, -4083, 128, -4494, -3585, 2378, 2478, 1700, -2829, -205, -7, -3650, -4990, 678, -436, 1645, 1708, -3800, 703, -3934, 2576, 65, 1643, -783, -1101, -3181, -816, 4283, -304, 3024, 4002, 1654, 2113, -4022, 1889, 3977, -302, -4412, -3523, -267, -2569, 4817, -1311, -1331, -2112, 1037, 1185, -3328, 1116, -327, 1311, 4360, -3827, 338, -3443, -1356, -2852, -1054, 187, 1018, 1492, -1427, 1649, -2948, -902, 3849, -3123, 685, 4550, -4265, -3991, 904, 4969, 2203, -3660, 4557, 3500, 3743, -211, 71, 515, -1860, -3678, 2769, -2449, 4825, -2619, 1874, -182, -4428, 2654, 4191, -2559, -1752, 3823, -3106, 2944, 1574, -4565, -972, 4627, -1463, 502, 903, 4666, 1916, -2050, 3885, 4457, 512, 1297, 2020, 2776, 1363, 3396, -3872, -2182, 4005, 4931, 4080, 2487, -1830, -4946, -1857, -2794, 486, 3164, 1642, -4369, 4223, -2799, -2408, 4217, 1214, -2172, -4175, -2257, -108, -315, 1519, 2617, 3180, -2935, 3174, 2084, -754, 2457, -3155, 4303, 3074, 1941, -4025, 3570, 847, 2152, 4903, 132, -1015, -4712, 1518, -2078, 1982, 1336, 4168, -4262, -139, 2789, -3837, 4774, 1741, 2605, -2903, 347, -3836, 2773, 1369, 4390, 2842, 1255, -2886, -675, 3389, -27, 2085, -2718, -510, -1599, -116, -2211, -3790, 3357, -3571, -4166, 1299, -2373, 570, -793, 769, -4230, 1819, 863, -2007, -745, -578, -2344, 299, -4473, -3748, -2159, -2737, -105, 3464, 4351, 908, 2138, 897, -3437, -4976, 1260, 1068, -1781, 2742, 281, 1734, 3541, -4299, 2390, -69, -4137, -2428, 3223, -2970, -3393, -4158, -2766, -114, 1735, -3416, 4000, -2960, -2523, 373, -860, -3248, 3052, -3630, -2042, 4780, 2329, 3854, 2681, 2847, 1473, 3704, -3968, 3370, 3095, -2374, -1141, -153, -4464, 251, 640, -2513, 63, 1361, -842, -2057, 1074, -4801, 3490, 3746, -2140, -4679, 4009, -3180, -2898, -815, 1195, -1171, 840, 4219, -3607, -4276, 681, 4248, 2682, 2163, 2004, -944, 3596, 3822, 2577, -3904, 79, -4680, 929, -2199, -1270, -3793, 3009, 2080, 3192, -4307, -809, -4586, -2759, -2848, 1483, 3194, -21, 392, -13, 3230, 466, 977, -3722, 2812, -1620, 2447, 442, 3675, -460, -3980, -3589, -295, 3663, -1388, 1442, 1880, 3637, 3269, 3922, -4193, 3784, 855, 91, 3267, -4233, 163, -569, 2226, -3554, 3228, -790, -4442, -3744, -2874, 3284, 4876, 1792, -626, -682, 3605, -4917, -3491, 2464, -2556, 18, 4770, 3722, 1367, -4109, 2021, -3587, 1539, -655, -2282, 4733, 3631, -4444, 3528, -4143, 2352, 462, 2006, -4942, 894, -3372, 435, -3656, 2166, 294, -226, 3442, -4176, -601, -4062, -3108, -2289, -4991, -3824, -3041, 498, 432, 329, -1883, -1547, -4718, -3826, 3961, -2684, -4618, -1418, 3431, 53, -3243, 602, -301, -3063, -3999, -1232, 375, -3397, 2696, 1271, -2213, 2486, -761, 2899, -1303, 124, -2734, -2388, -1847, 2414, 1309, -3104, -3126, 1203, 1223, 4649, -2075, 4019, 4174, 3650, 2775, 3789, 2423, -1976, 3846, -272, -4706, -3206, 620, 1403, -3219, -4280, 764, 1304, 1760, -1804, 1344, 4278, -111, 1244, 2738, 4275, -4403, 3125, 1481, -4033, -1813, 2714, 2729, -2647, 2242, 3098, -3346, 1827, -4079, -3516, 3561, 3328, -4556, 1329, -1811, -4657, 4686, 1504, 2204, -41, 1867, -2703, 2763, -3847, -2317, -4420, -1108, -3721, 3324, -3054, 2205, -2395, 2475, -4503, 2366, 463, -4600, -2669, 4165, 4295, 3665, -2102, 4745, 867, 4790, -4859, 3498, -2578, -499, 3617, -4361, 3817, 4795, -2815, 4979, 3050, 208, -1306, -3489, 1066, -3958, -1557, 2050, -343, -4667, 4562, -1099, -545, -4381, -4663, 4676, 1272, -3982, 1995, 480, 3273, 3099, 285, -2851, 1744, -1047, -3350, -3671, -3386, 1767, 2609, -3760, 3687, -4408, 1453, -2443, 898, 2239, -1936, 2243, -4983, -2865, 1081, -1695, 569, -3978, -4468, -1205, 1890, 1945, -3724, 594, -135, -2179, 457, -378, 653, 3530, 4124, 3947, 1586, 1625, -4610, 3493, 318, 4333, 1463, -3141, -241, -749, 172, -2891, 1070, -1837, -4042, -1850, -2982, 2880, 3939, -3651, -3794, -220, 2135, 1629, 3434, -4348, -81, -3604, 3527, 4823, 3216, 4273, 3278, -3122, 2845, -3188, 2816, 3765, 2340, 4269, -22, -2777, -3456, -173, -2430, 1122, 3275, 4724, -2652, 3120, -1498, 2786, -1984, -4016, -2049, -1236, -2165, 609, -2365, -864, -720, 792, 2805, 181, -3820, -2185, -4644, -383, 4027, 304, -3767, 104, -2376, 1228, -4069, -708, 4811, 4760, 3719, 934, 3618, 4829, 1315, 1749, 1114, 2588, -1553, 3084, 211, -1973, -2967, 3108, -3095, 64, 805, 195, -903, 2618, -3410, -4023, -1626, -1028, 979, -4753, -3673, 3926, 1391, -4641, -1954, 3057, -1319, 3302, -2709, -4693, -3772, 3871, 4516, 991, 4981, -4852, 882, -945, -2661, -459, 3345, -2270, -558, 2259, 1394, -4536, -127, -3369, 287, 1733, -4959, 3946, -3483, -1381, 577, -3576, -3715, 3838, -4587, -1911, -4191, 1432, 3839, -884, 2056, 4687, 4793, 3992, 684, -3957, 4692, 3754, -2750, 4100, -722, -3703, -1842, 2687, 1484, 4212, 4059, -2092, -1274, -2509, -4365, -2116, -3634, -4502, 772, -2252, -4284, 2621, -4829, -131, 182, -827, 1843, 4397, -2367, -4496, -3913, -4777, 2465, -2175, 409, 4830, -3298, 1921, -2363, -1909, 4977, 2220, -515, -536, -2331, 1177, 4684, -2933, 1958, -4849, -3574, 1691, 4096, 2019, 307, 3897, 3170, 2319, 4052, -4754, -275, 2351, -4800, 4056, -1702, 4358, -42, -4483, 4704, -2582, -1072, -130, -16, 3417, 3070, -4324, 3727, -3202, 4831, 377, 923, 2846, 4503, -4834, 901, 1554, -512, 4227, -1799, 767, 3215, 2197, -258, 93, 174, -1972, -3645, -3881, -1805, 1597, 3979, -4416, -1982, -2030, 4073, 3407, -3338, 3603, 4464, 86, -1276, -126, 2356, 606, -1946, -2705, -2984, 48, 2271, -4094, 576, 2943, -4332, -615, -2823, -4616, -2109, 1033, 200, 3032, -3976, 679, 3553, -566, 1171, -2237, -4591, -1821, 1794, 4620, -2313, -3209, 3355, -2572, -4370, 3950, 4350, -4771, -1445, 3469, 427, 4754, -4266, 705, -199, 750, -1551, -74, 3794, -2749, 3973, 1793, 3140, -317, -1559, 727, 3146, 4184, -1947, -2045, 1764, -4198, -3579, 1112, 3656, 2640, 1123, 255, 3226, -2303, -2691, -2099, 85, 1994, -919, -4766, 4654, -3501, 4173, 3791, -1871, 1812, 4237, 520, -4278, -1665, -2812, -1481, -83, -4545, -3452, 98, 2436, -4517, 2975, 3595, 2795, 3798, -4538, -195, -828, 3279, 306, 4985, 1218, 558, -4887, 3001, 478, 190, 1428, 1613, 88, 2313, -3227, 3175, -2551, 4596, -3101, -3845, -3124, 1538, -3833, -819, -4267, 3023, -1001, 1587, -2822, 2874, 2256, -3955, -360, -265, 2995, -645, 3179, 1407, 488, -3311, 3380, -1516, 3372, 1180, 1166, -896, 3679, 1408, 4794, 3545, 2111, -940, 4848, 1456, -1582, 2254, 2405, 4461, -2778, -556, -3218, 912, 1857, -2040, -3654, -4719, 1005, 549, 4577, -2107, -3989, 1258, -2348, -3256, 141, -1402, 852, 4357, -1196, -3704, 1382, 4347, 1712, -2654, 150, 2343, 4809, 4540, -2456, -4029, -951, 3312, -3030, 4690, 3468, -622, 2278, -506, 3040, 513, 2368, -1713, -1138, 3604, 3234, -1016, 4352, 1279, 2516, -2617, 3514, -409, -1970, -2254, 3143, 1235, -2825, -3692, -650, -454, -2011, 2199, 1040, 2386, 2466, -2021, -927, 4271, -1128, 2971, 4050},
    };
 
+   for (auto test_case : test_cases)
+   {
+      vector<int> bottom_up = test_case;
+      mergeSortBottomUp(bottom_up);
+      if (!verify(bottom_up, test_case))
+         cout << "(FAILED!) Bottom-up, Unsorted = " << test_case << ", Sorted = " << bottom_up << endl;
+   }
+
    for (auto &test_case : test_cases)
    {
       vector<int> original = test_case;
@@ -120,5 +832,214 @@ int main()
       cout << endl;
    }
 
+   // Records sorted through the generic API: by a projected key, in descending order, and in key-value mode, each checked
+   // against std::stable_sort
+   {
+      struct Record
+      {
+         int64_t key;
+         string payload;
+
+         bool operator==(Record const &other) const
+         {
+            return key == other.key && payload == other.payload;
+         }
+      };
+      mt19937 rng(15);
+      vector<Record> records;
+      for (int i = 0; i < 1000; ++i)
+         records.push_back({int64_t(rng() % 50) << 40, "record " + to_string(i)});
+      auto key = [](Record const &r) { return r.key; };
+
+      vector<Record> expected = records, projected = records, by_key = records;
+      stable_sort(expected.begin(), expected.end(), [](Record const &a, Record const &b) { return a.key < b.key; });
+      mergeSort(projected.begin(), projected.end(), less<>(), key);
+      mergeSortByKey(by_key.begin(), by_key.end(), key);
+
+      vector<Record> expected_descending = records, descending = records;
+      stable_sort(expected_descending.begin(), expected_descending.end(), [](Record const &a, Record const &b) { return a.key > b.key; });
+      mergeSort(descending.begin(), descending.end(), greater<>(), key);
+
+      vector<int> ints = test_cases[0];
+      mergeSort(ints.begin(), ints.end());
+
+      bool success = projected == expected && by_key == expected && descending == expected_descending && verify(ints, test_cases[0]);
+      if (!success)
+         cout << "(FAILED!) ";
+      cout << "Generic API: records sorted by key, by key descending and in key-value mode" << endl;
+   }
+
+   // The same test cases again, sharing one buffer, which must not be reallocated once it is long enough for all of them
+   {
+      vector<int> buffer;
+      int longest = 0;
+      for (auto const &test_case : test_cases)
+         longest = max(longest, int(test_case.size()));
+      buffer.reserve(longest);
+      int const *allocation = buffer.data();
+
+      bool success = true;
+      for (auto const &test_case : test_cases)
+      {
+         vector<int> sorted = test_case;
+         mergeSort(sorted.data(), sorted.size(), buffer);
+         success = success && verify(sorted, test_case) && buffer.data() == allocation;
+      }
+      if (!success)
+         cout << "(FAILED!) ";
+      cout << "Shared buffer: all test cases sorted with one allocation" << endl;
+   }
+
+   // Top-down against bottom-up, on sizes around the run and block boundaries and on one large array
+   {
+      mt19937 rng(11);
+      vector<int> buffer;
+      for (int n : {31, 32, 33, 4095, 4096, 4097, 65535, 65537, 100000, 1 << 20})
+      {
+         vector<int> original(n);
+         for (int &x : original)
+            x = int(rng() % 1000000) - 500000;
+
+         vector<int> top_down = original, bottom_up = original;
+         auto start = chrono::steady_clock::now();
+         mergeSort(top_down.data(), n, buffer);
+         auto middle = chrono::steady_clock::now();
+         mergeSortBottomUp(bottom_up.data(), n, buffer);
+         auto end = chrono::steady_clock::now();
+
+         bool success = verify(top_down, original) && verify(bottom_up, original);
+         if (!success)
+            cout << "(FAILED!) ";
+         cout << n << " elements: top-down " << chrono::duration<double, milli>(middle - start).count() << " ms, bottom-up "
+              << chrono::duration<double, milli>(end - middle).count() << " ms" << endl;
+      }
+   }
+
+   // The parallel sort, checked for exactly the output of the sequential one with any number of threads, on arrays with many
+   // duplicates
+   {
+      mt19937 rng(13);
+      vector<int> buffer;
+      for (int n : {0, 1, 5000, 4 * L1_BLOCK - 1, 100000, 1 << 22})
+      {
+         vector<int> original(n);
+         for (int &x : original)
+            x = int(rng() % 1000);
+         vector<int> expected = original;
+         mergeSort(expected.data(), n, buffer);
+
+         for (int threads : {1, 2, 3, 4, 7, 8})
+         {
+            vector<int> sorted = original;
+            auto start = chrono::steady_clock::now();
+            mergeSortParallel(sorted.data(), n, buffer, threads);
+            auto end = chrono::steady_clock::now();
+            if (sorted != expected)
+               cout << "(FAILED!) ";
+            if (n == 1 << 22 || sorted != expected)
+               cout << n << " elements, " << threads << " threads: parallel " << chrono::duration<double, milli>(end - start).count() << " ms" << endl;
+         }
+      }
+   }
+
+   // The merge kernels: checked against each other on merges of every small length, then timed on whole sorts of random and
+   // nearly-sorted (1% of the elements swapped at random) arrays
+   {
+      vector<pair<string, MergeKernel>> merge_kernels = {{"branching", mergeBranching}, {"branchless", mergeBranchless}};
+#if defined(MERGESORT_X86_KERNELS)
+      if (__builtin_cpu_supports("avx2"))
+         merge_kernels.push_back({"avx2", mergeAvx2});
+#endif
+      MergeKernel selected = mergeKernel;
+
+      mt19937 rng(14);
+      bool success = true;
+      for (int n_a = 0; n_a < 40; ++n_a)
+         for (int n_b = 0; n_b < 40; ++n_b)
+         {
+            vector<int> a(n_a), b(n_b);
+            for (int &x : a)
+               x = int(rng() % 20) - 10;
+            for (int &x : b)
+               x = int(rng() % 20) - 10;
+            sort(a.begin(), a.end());
+            sort(b.begin(), b.end());
+            vector<int> expected(n_a + n_b), merged(n_a + n_b);
+            mergeBranching(a.data(), n_a, b.data(), n_b, expected.data());
+            for (auto const &kernel : merge_kernels)
+            {
+               kernel.second(a.data(), n_a, b.data(), n_b, merged.data());
+               success = success && merged == expected;
+            }
+         }
+      if (!success)
+         cout << "(FAILED!) ";
+      cout << "Merge kernels agree on all merges of up to 39 + 39 elements" << endl;
+
+      int n = 1 << 22;
+      vector<int> random(n), nearly_sorted(n);
+      for (int i = 0; i < n; ++i)
+      {
+         random[i] = int(rng());
+         nearly_sorted[i] = i;
+      }
+      for (int swaps = 0; swaps < n / 100; ++swaps)
+         swap(nearly_sorted[rng() % n], nearly_sorted[rng() % n]);
+
+      vector<int> buffer;
+      for (auto const &input : {make_pair("random", &random), make_pair("nearly sorted", &nearly_sorted)})
+         for (auto const &kernel : merge_kernels)
+         {
+            mergeKernel = kernel.second;
+            vector<int> sorted = *input.second;
+            auto start = chrono::steady_clock::now();
+            mergeSortBottomUp(sorted.data(), n, buffer);
+            auto end = chrono::steady_clock::now();
+            if (!is_sorted(sorted.begin(), sorted.end()))
+               cout << "(FAILED!) ";
+            cout << n << " elements, " << input.first << ", " << kernel.first << " merge: " << chrono::duration<double, milli>(end - start).count() << " ms" << endl;
+         }
+      mergeKernel = selected;
+   }
+
+   // The external sort, with a budget small enough for many runs and more than one merge pass, checked against the
+   // in-memory sort
+   {
+      mt19937 rng(16);
+      filesystem::path directory = filesystem::temp_directory_path();
+      string input_path = (directory / "mergesort_input.txt").string(), output_path = (directory / "mergesort_output.txt").string();
+      vector<int> original(300000);
+      {
+         ofstream input(input_path);
+         for (int &x : original)
+         {
+            x = int(rng());
+            input << x << (rng() % 8 == 0 ? "\n" : "  ");
+         }
+      }
+      ExternalSortOptions options;
+      options.memory_budget = 1 << 16;
+      options.io_buffer = 1 << 12;
+      options.threads = 2;
+      bool success = externalMergeSort(input_path, output_path, options);
+
+      vector<int> sorted;
+      ifstream output(output_path);
+      for (int x; output >> x;)
+         sorted.push_back(x);
+      success = success && sorted.size() == original.size() && verify(sorted, original);
+      if (!success)
+         cout << "(FAILED!) ";
+      cout << "External sort: " << original.size() << " ints in runs of " << options.memory_budget / 8 << endl;
+
+      ofstream(input_path) << "1 2 x3";
+      bool rejected = !externalMergeSort(input_path, output_path, options);
+      if (!rejected)
+         cout << "(FAILED!) ";
+      cout << "External sort: invalid input rejected" << endl;
+      filesystem::remove(input_path);
+      filesystem::remove(output_path);
+   }
+
    return 0;
 }
\ No newline at end of file
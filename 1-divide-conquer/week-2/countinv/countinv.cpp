@@ -3,7 +3,14 @@
 #include <dirent.h> // UNIX only; for Windows, need to get it elsewhere, see https://stackoverflow.com/a/612176/3477043
 
 #include <vector>
+#include <deque>
 #include <algorithm>
+#include <cstdint>
+#include <thread>
+#include <random>
+#include <chrono>
+#include <cassert>
+#include <cmath>
 
 using namespace std;
 
@@ -87,6 +94,324 @@ size_t countInversions(vector<int> const &v)
    return countInversions(copy, 0, v.size() - 1);
 }
 
+// Merge the sorted arrays a[0, n_a) and b[0, n_b) into out[0, n_a + n_b), returning the number of inversions between them:
+// pairs of an element of a and a smaller element of b. a may be the first n_a of rest_of_a elements of a longer sorted run
+// (and b a piece of the run after it, see coRank()), in which case the count covers the rest of that run too
+size_t mergeAndCountInversions(int const *a, int n_a, int const *b, int n_b, int *out, int64_t rest_of_a)
+{
+   size_t count = 0;
+   int i = 0, j = 0;
+   while (i < n_a && j < n_b)
+   {
+      if (a[i] <= b[j])
+         *out++ = a[i++];
+      else
+      {
+         *out++ = b[j++];
+         count += rest_of_a - i;
+      }
+   }
+   // Any elements of b that are left come before the rest of the run of a, so they are smaller than all of it
+   count += size_t(n_b - j) * (rest_of_a - n_a);
+   out = copy(a + i, a + n_a, out);
+   copy(b + j, b + n_b, out);
+   return count;
+}
+
+// Count the inversions of v[0, n) while sorting it with a ping-pong mergesort into buffer if into_buffer, otherwise into v
+size_t countInversionsPingPong(int *v, int *buffer, int n, bool into_buffer)
+{
+   if (n <= 1)
+   {
+      if (into_buffer && n == 1)
+         buffer[0] = v[0];
+      return 0;
+   }
+
+   int n_a = n / 2;
+   size_t count = countInversionsPingPong(v, buffer, n_a, !into_buffer) + countInversionsPingPong(v + n_a, buffer + n_a, n - n_a, !into_buffer);
+   if (into_buffer)
+      return count + mergeAndCountInversions(v, n_a, v + n_a, n - n_a, buffer, n_a);
+   else
+      return count + mergeAndCountInversions(buffer, n_a, buffer + n_a, n - n_a, v, n_a);
+}
+
+// Merge path ("co-ranking"): the number of elements of a among the first d elements of the stable merge of a[0, n_a) and
+// b[0, n_b). Cutting both inputs there splits the merge into two halves that can be merged independently
+int coRank(int d, int const *a, int n_a, int const *b, int n_b)
+{
+   int low = max(0, d - n_b), high = min(d, n_a);
+   while (low < high)
+   {
+      // Taking i elements from a (and d - i from b) is too few if a[i] still comes before b[d - i - 1] in the merge
+      int i = low + (high - low) / 2;
+      if (a[i] <= b[d - i - 1])
+         low = i + 1;
+      else
+         high = i;
+   }
+   return low;
+}
+
+// Per-thread inversion count, padded to a cache line of its own so that threads never write to the same line
+struct alignas(64) InversionCounter
+{
+   size_t count = 0;
+};
+
+// Multithreaded inversion count, the same as countInversions(). v is cut into one chunk per thread and the inversions
+// within the chunks are counted concurrently (sorting them); then adjacent sorted runs are merged pairwise in rounds,
+// each merge cut with merge path into pieces that run concurrently and count the inversions between the runs for the
+// elements of the second run they take. Every thread adds to its own counter, and the counters are summed at the end
+size_t countInversionsParallel(vector<int> const &v, int threads)
+{
+   int n = v.size();
+   threads = max(1, min(threads, n / 4096)); // a thread per chunk smaller than this would cost more than it saves
+
+   vector<int> bounds; // the sorted runs are [bounds[r], bounds[r + 1])
+   for (int t = 0; t <= threads; ++t)
+      bounds.push_back(int64_t(n) * t / threads);
+   int rounds = 0;
+   for (int runs = threads; runs > 1; runs = (runs + 1) / 2)
+      ++rounds;
+
+   // The rounds alternate between the two arrays, so sort the chunks into whichever one the last round ends in; which one
+   // that is does not matter here, as the sorted copy is thrown away
+   vector<int> copy = v, buffer(n);
+   int *src = rounds % 2 == 1 ? buffer.data() : copy.data(), *dst = src == copy.data() ? buffer.data() : copy.data();
+   vector<InversionCounter> counters(threads);
+   {
+      vector<thread> workers;
+      for (int t = 0; t < threads; ++t)
+         workers.emplace_back([&, t]() {
+            counters[t].count += countInversionsPingPong(copy.data() + bounds[t], buffer.data() + bounds[t], bounds[t + 1] - bounds[t], rounds % 2 == 1);
+         });
+      for (thread &worker : workers)
+         worker.join();
+   }
+
+   for (; bounds.size() > 2; swap(src, dst))
+   {
+      // A merge gets at most one piece more than its share of the threads, so this is a counter for every piece
+      int round_start = counters.size();
+      counters.resize(round_start + threads + bounds.size());
+      int piece_counter = round_start;
+
+      vector<int> merged_bounds;
+      vector<thread> workers;
+      for (size_t r = 0; r + 1 < bounds.size(); r += 2)
+      {
+         // An odd run out is merged with an empty one, which copies it across
+         int start = bounds[r], middle = bounds[r + 1], end = r + 2 < bounds.size() ? bounds[r + 2] : middle;
+         merged_bounds.push_back(start);
+         int const *a = src + start, *b = src + middle;
+         int n_a = middle - start, n_b = end - middle;
+         int pieces = max<int64_t>(1, int64_t(threads) * (end - start) / n);
+         for (int p = 0; p < pieces; ++p)
+         {
+            int first = int64_t(end - start) * p / pieces, last = int64_t(end - start) * (p + 1) / pieces;
+            workers.emplace_back([=, &counters, counter = piece_counter++]() {
+               int first_a = coRank(first, a, n_a, b, n_b), last_a = coRank(last, a, n_a, b, n_b);
+               counters[counter].count += mergeAndCountInversions(a + first_a, last_a - first_a, b + first - first_a, (last - last_a) - (first - first_a), dst + start + first, n_a - first_a);
+            });
+         }
+      }
+      merged_bounds.push_back(n);
+      for (thread &worker : workers)
+         worker.join();
+      bounds = merged_bounds;
+   }
+
+   size_t count = 0;
+   for (InversionCounter const &counter : counters)
+      count += counter.count;
+   return count;
+}
+
+// Inversion count for keys in [min_key, max_key] with a Binary Indexed (Fenwick) tree over the key range: scanning left to
+// right, each element makes an inversion with every earlier element greater than it, which is the number of earlier
+// elements minus the number of those that are at most it, a prefix count the tree answers in O(log(range)). The tree is
+// one int per key, so this is only a good idea when the range is small
+size_t countInversionsFenwick(vector<int> const &v, int min_key, int max_key)
+{
+   assert(int64_t(max_key) - min_key < INT32_MAX);
+   int range = max_key - min_key + 1;
+   vector<unsigned> tree(range + 1); // tree[k] counts the elements with keys in (k - lowbit(k), k], keys shifted to start at 1
+   size_t count = 0;
+   for (size_t i = 0; i < v.size(); ++i)
+   {
+      int key = v[i] - min_key + 1;
+      size_t at_most_key = 0;
+      for (int k = key; k > 0; k &= k - 1)
+         at_most_key += tree[k];
+      count += i - at_most_key;
+      for (int k = key; k <= range; k += k & -k)
+         ++tree[k];
+   }
+   return count;
+}
+
+// Key range up to which countInversionsFenwick() always beats the mergesort count, since the tree stays in the L2 cache.
+// Past it the tree still wins while the range is at most the number of elements; at 4M elements it takes half the time of
+// the mergesort count for a range of 4M and falls behind somewhere before a range of 16M
+int const FENWICK_MAX_RANGE = 1 << 18;
+
+// Counts inversions with whichever engine suits the input: the Fenwick tree if the keys span a small enough range, the
+// parallel mergesort count otherwise
+size_t countInversionsAuto(vector<int> const &v, int threads = thread::hardware_concurrency())
+{
+   if (v.empty())
+      return 0;
+
+   auto extremes = minmax_element(v.begin(), v.end());
+   int64_t range = int64_t(*extremes.second) - *extremes.first + 1;
+   if (range <= max<int64_t>(FENWICK_MAX_RANGE, v.size()))
+      return countInversionsFenwick(v, *extremes.first, *extremes.second);
+   return countInversionsParallel(v, threads);
+}
+
+// Inversion count of a sliding window over a stream: elements are appended at the back and expired from the front, and
+// the count of the current window is kept up to date in O(log(keys)) per update. The window is kept as ranks among the
+// possible keys, given up front, and a Binary Indexed (Fenwick) tree over the ranks counts how many window elements fall
+// at or below a rank
+class SlidingInversionCounter
+{
+   vector<int> keys;     // the possible keys, sorted without duplicates; key keys[r - 1] has rank r
+   vector<unsigned> tree; // tree[r] counts the window elements with ranks in (r - lowbit(r), r]
+   deque<int> window;     // ranks of the window elements, oldest first
+   size_t inversions = 0;
+
+   int Rank(int key) const
+   {
+      auto it = lower_bound(keys.begin(), keys.end(), key);
+      assert(it != keys.end() && *it == key);
+      return int(it - keys.begin()) + 1;
+   }
+
+   size_t CountAtMost(int rank) const
+   {
+      size_t count = 0;
+      for (int r = rank; r > 0; r &= r - 1)
+         count += tree[r];
+      return count;
+   }
+
+   void Add(int rank, int delta)
+   {
+      for (int r = rank; r < tree.size(); r += r & -r)
+         tree[r] += delta;
+   }
+
+public:
+   SlidingInversionCounter(vector<int> _keys) : keys(move(_keys))
+   {
+      sort(keys.begin(), keys.end());
+      keys.erase(unique(keys.begin(), keys.end()), keys.end());
+      tree.resize(keys.size() + 1);
+   }
+
+   // Appends key at the back of the window: it makes an inversion with every window element greater than it
+   void Append(int key)
+   {
+      int rank = Rank(key);
+      inversions += window.size() - CountAtMost(rank);
+      Add(rank, 1);
+      window.push_back(rank);
+   }
+
+   // Expires the oldest element of the window: it made an inversion with every later element less than it
+   void Expire()
+   {
+      assert(!window.empty());
+      int rank = window.front();
+      window.pop_front();
+      Add(rank, -1);
+      inversions -= CountAtMost(rank - 1);
+   }
+
+   size_t Count() const
+   {
+      return inversions;
+   }
+
+   size_t size() const
+   {
+      return window.size();
+   }
+};
+
+// An estimated inversion count: with probability at least confidence, the exact count is within error of inversions
+struct InversionEstimate
+{
+   double inversions;
+   double error;
+   double confidence;
+   size_t samples;
+};
+
+// Estimates the fraction of the pairs i < j of [0, n) for which discordant(i, j) holds, from uniformly sampled pairs, and
+// scales it to the number of pairs. By Hoeffding's inequality, ln(2 / (1 - confidence)) / (2 * epsilon^2) samples put the
+// sampled fraction within epsilon of the true one with probability at least confidence, whatever n is, so the cost does
+// not grow with the input. If that is more samples than there are pairs it just checks them all
+template <typename Discordant>
+InversionEstimate estimateDiscordantPairs(size_t n, Discordant discordant, double epsilon, double confidence, mt19937_64 &rng)
+{
+   double pairs = n < 2 ? 0 : double(n) * (n - 1) / 2;
+   size_t samples = ceil(log(2 / (1 - confidence)) / (2 * epsilon * epsilon));
+   if (samples >= pairs)
+   {
+      size_t count = 0;
+      for (size_t i = 0; i < n; ++i)
+         for (size_t j = i + 1; j < n; ++j)
+            count += discordant(i, j);
+      return {double(count), 0, 1, size_t(pairs)};
+   }
+
+   uniform_int_distribution<size_t> index(0, n - 1);
+   size_t hits = 0;
+   for (size_t s = 0; s < samples; ++s)
+   {
+      size_t i = index(rng), j = index(rng);
+      for (; i == j; j = index(rng))
+         ;
+      hits += i < j ? discordant(i, j) : discordant(j, i);
+   }
+   return {pairs * hits / samples, pairs * epsilon, confidence, samples};
+}
+
+// Estimated inversion count of v, within epsilon times the number of pairs with probability at least confidence
+InversionEstimate estimateInversions(vector<int> const &v, double epsilon, double confidence, mt19937_64 &rng)
+{
+   return estimateDiscordantPairs(v.size(), [&](size_t i, size_t j) { return v[i] > v[j]; }, epsilon, confidence, rng);
+}
+
+// Kendall tau distance between two rankings of the same items, where item i is ranked a[i] by one and b[i] by the other:
+// the number of pairs of items the two rankings put in opposite orders. That is the inversion count of the b ranks taken in
+// the order of the a ranks, with items tied in a ordered by b so that ties do not count
+size_t kendallTauDistance(vector<int> const &a, vector<int> const &b, int threads = thread::hardware_concurrency())
+{
+   assert(a.size() == b.size());
+   vector<pair<int, int>> ranks(a.size());
+   for (size_t i = 0; i < a.size(); ++i)
+      ranks[i] = {a[i], b[i]};
+   sort(ranks.begin(), ranks.end());
+
+   vector<int> b_in_a_order(ranks.size());
+   for (size_t i = 0; i < ranks.size(); ++i)
+      b_in_a_order[i] = ranks[i].second;
+   return countInversionsAuto(b_in_a_order, threads);
+}
+
+// Estimated Kendall tau distance between the rankings a and b, within epsilon times the number of pairs with probability
+// at least confidence
+InversionEstimate estimateKendallTauDistance(vector<int> const &a, vector<int> const &b, double epsilon, double confidence, mt19937_64 &rng)
+{
+   assert(a.size() == b.size());
+   return estimateDiscordantPairs(a.size(), [&](size_t i, size_t j) {
+      return (a[i] < a[j] && b[i] > b[j]) || (a[i] > a[j] && b[i] < b[j]);
+   }, epsilon, confidence, rng);
+}
+
 int main()
 {
    // Find all test case files (courtesy of https://stackoverflow.com/a/612176/3477043)
@@ -111,7 +436,8 @@ int main()
    // Sort them
    sort(test_case_files.begin(), test_case_files.end());
 
-   // For each case, read the file and compute the number of inversions
+   // For each case, read the file and compute the number of inversions, and an estimate of it from sampled pairs
+   mt19937_64 estimate_rng(20);
    int const n_start = 1, n = test_case_files.size();
    for (auto it = test_case_files.begin() + n_start - 1; it != test_case_files.begin() + n_start - 1 + n; ++it)
    {
@@ -124,10 +450,142 @@ int main()
          test_case.push_back(x);
 
       size_t inversions = countInversions(test_case);
-      cout << "Inversions = " << inversions;
+      if (countInversionsParallel(test_case, 4) != inversions || countInversionsAuto(test_case) != inversions)
+         cout << "(FAILED!) Parallel or auto; ";
+      InversionEstimate estimate = estimateInversions(test_case, 0.01, 0.999, estimate_rng);
+      if (abs(estimate.inversions - double(inversions)) > estimate.error)
+         cout << "(FAILED!) Estimate; ";
+      cout << "Inversions = " << inversions << " (estimated " << estimate.inversions << " +/- " << estimate.error << ")";
       cout << "; " << filename;
       cout << "; " << endl;
    }
 
+   // The parallel count against the serial one, with any number of threads, on arrays with many duplicates
+   {
+      mt19937 rng(17);
+      for (int n : {0, 1, 5000, 3 * 4096 + 1, 100000, 1 << 22})
+      {
+         vector<int> v(n);
+         for (int &x : v)
+            x = int(rng() % 1000);
+         auto start = chrono::steady_clock::now();
+         size_t expected = countInversions(v);
+         auto end = chrono::steady_clock::now();
+         double serial = chrono::duration<double, milli>(end - start).count();
+
+         for (int threads : {1, 2, 3, 4, 7, 8})
+         {
+            start = chrono::steady_clock::now();
+            size_t inversions = countInversionsParallel(v, threads);
+            end = chrono::steady_clock::now();
+            if (inversions != expected)
+               cout << "(FAILED!) ";
+            if (n == 1 << 22 || inversions != expected)
+               cout << "Inversions = " << inversions << "; " << n << " elements, " << threads << " threads; serial " << serial << " ms, parallel "
+                    << chrono::duration<double, milli>(end - start).count() << " ms" << endl;
+         }
+      }
+   }
+
+   // The Fenwick tree count against the mergesort count on key ranges from tiny to past the number of elements, timed, along with
+   // the engine the driver picks
+   {
+      mt19937 rng(18);
+      int n = 1 << 22;
+      for (int64_t range : {int64_t(1) << 8, int64_t(1) << 16, int64_t(1) << 18, int64_t(1) << 20, int64_t(1) << 22, int64_t(1) << 24})
+      {
+         vector<int> v(n);
+         for (int &x : v)
+            x = int(int64_t(rng()) % range + INT32_MIN);
+
+         auto start = chrono::steady_clock::now();
+         size_t expected = countInversionsParallel(v, 1);
+         auto middle = chrono::steady_clock::now();
+         auto extremes = minmax_element(v.begin(), v.end());
+         size_t inversions = countInversionsFenwick(v, *extremes.first, *extremes.second);
+         auto end = chrono::steady_clock::now();
+
+         bool fenwick = range <= max<int64_t>(FENWICK_MAX_RANGE, n);
+         if (inversions != expected || countInversionsAuto(v, 1) != expected)
+            cout << "(FAILED!) ";
+         cout << "Inversions = " << inversions << "; " << n << " elements, key range " << range << "; mergesort "
+              << chrono::duration<double, milli>(middle - start).count() << " ms, Fenwick " << chrono::duration<double, milli>(end - middle).count()
+              << " ms; auto picks " << (fenwick ? "Fenwick" : "mergesort") << endl;
+      }
+   }
+
+   // The sliding window count against a count from scratch of the window after every update, with windows that grow,
+   // shrink and slide over keys with many duplicates, then timed on a long stream
+   {
+      mt19937 rng(19);
+      vector<int> keys;
+      for (int key = -500; key < 500; key += 7)
+         keys.push_back(key);
+
+      SlidingInversionCounter counter(keys);
+      deque<int> window;
+      bool success = true;
+      for (int update = 0; update < 20000; ++update)
+      {
+         int target = update < 5000 ? 300 : (update < 10000 ? 40 : 150); // window size the updates drift towards
+         if (!window.empty() && (window.size() > target || rng() % 4 == 0))
+         {
+            counter.Expire();
+            window.pop_front();
+         }
+         else
+         {
+            int key = keys[rng() % keys.size()];
+            counter.Append(key);
+            window.push_back(key);
+         }
+         success = success && counter.size() == window.size() && counter.Count() == countInversions(vector<int>(window.begin(), window.end()));
+      }
+
+      int n = 1 << 22, width = 1 << 16;
+      vector<int> stream(n);
+      for (int &x : stream)
+         x = int(rng() % 1000000);
+      SlidingInversionCounter long_counter(stream);
+      auto start = chrono::steady_clock::now();
+      for (int i = 0; i < n; ++i)
+      {
+         long_counter.Append(stream[i]);
+         if (i >= width)
+            long_counter.Expire();
+      }
+      auto end = chrono::steady_clock::now();
+      success = success && long_counter.Count() == countInversions(vector<int>(stream.end() - width, stream.end()));
+
+      cout << (success ? "" : "(FAILED!) ") << "Sliding window: " << n << " appends, window of " << width << ", in "
+           << chrono::duration<double, milli>(end - start).count() << " ms; final count = " << long_counter.Count() << endl;
+   }
+
+   // The estimated Kendall tau distance against the exact one, between a ranking and a copy of it with some items moved,
+   // with a timing of each
+   {
+      mt19937_64 rng(20);
+      int n = 1 << 22;
+      vector<int> a(n), b(n);
+      for (int i = 0; i < n; ++i)
+         a[i] = i;
+      shuffle(a.begin(), a.end(), rng);
+      b = a;
+      for (int swaps = 0; swaps < n / 8; ++swaps)
+         swap(b[rng() % n], b[rng() % n]);
+
+      auto start = chrono::steady_clock::now();
+      size_t exact = kendallTauDistance(a, b);
+      auto middle = chrono::steady_clock::now();
+      InversionEstimate estimate = estimateKendallTauDistance(a, b, 0.001, 0.99, rng);
+      auto end = chrono::steady_clock::now();
+
+      if (abs(estimate.inversions - double(exact)) > estimate.error)
+         cout << "(FAILED!) ";
+      cout << "Kendall tau distance = " << exact << " in " << chrono::duration<double, milli>(middle - start).count() << " ms; estimated "
+           << estimate.inversions << " +/- " << estimate.error << " with confidence " << estimate.confidence << " from " << estimate.samples
+           << " samples in " << chrono::duration<double, milli>(end - middle).count() << " ms" << endl;
+   }
+
    return 0;
 }
\ No newline at end of file
@@ -20,6 +20,18 @@
 #include <array>
 #include <vector>
 #include <algorithm>
+#include <functional>
+#include <iterator>
+#include <random>
+#include <type_traits>
+#include <chrono>
+#include <cmath>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
 
 using namespace std;
 
@@ -56,63 +68,111 @@ enum ChoiceOfPivot
 {
    FIRST,
    LAST,
-   MEDIAN
+   MEDIAN,
+   NINTHER
 };
 
-int chooseMedianOfThree(int a, int b, int c, vector<int> const &v)
+// Projection that leaves the elements as they are
+struct Identity
 {
-   array<int, 3> candidates = {a, b, c};
-   sort(candidates.begin(), candidates.end(), [&](auto const x, auto const y) { return v[x] < v[y]; });
-   return candidates[1]; // the median
-}
+   template <typename T>
+   T &&operator()(T &&x) const
+   {
+      return forward<T>(x);
+   }
+};
 
-int quickSort(int start, int end, vector<int> &v, ChoiceOfPivot const pivotChoice) // start is inclusive but end is EXCLUSIVE
+template <typename RandomIt, typename Compare, typename Projection>
+RandomIt chooseMedianOfThree(RandomIt a, RandomIt b, RandomIt c, Compare &comp, Projection &proj)
 {
-   int n = end - start;
+   array<RandomIt, 3> candidates = {a, b, c};
+   sort(candidates.begin(), candidates.end(), [&](RandomIt x, RandomIt y) { return comp(proj(*x), proj(*y)); });
+   return candidates[1]; // the median
+}
 
-   if (n < 2)
-      return 0;
+// Ranges at least this long use Tukey's ninther for the NINTHER choice of pivot, shorter ones a plain median-of-three
+int const NINTHER_THRESHOLD = 128;
 
-   // Select the pivot
-   int last = end - 1;
-   int pivot_initial;
+// The element of [first, last) to use as the pivot under pivotChoice; [first, last) must not be empty
+template <typename RandomIt, typename Compare, typename Projection>
+RandomIt choosePivot(RandomIt first, RandomIt last, ChoiceOfPivot const pivotChoice, Compare &comp, Projection &proj)
+{
+   int n = last - first;
+   RandomIt back = last - 1;
    switch (pivotChoice)
    {
    case LAST:
-      pivot_initial = last;
-      break;
+      return back;
    case MEDIAN:
-      pivot_initial = chooseMedianOfThree(start, start + n / 2 - (n % 2 == 0 ? 1 : 0), last, v); // major note: NEVER forget to count FROM `start` and NOT implicitly from `0`!
-      break;
+      return chooseMedianOfThree(first, first + n / 2 - (n % 2 == 0 ? 1 : 0), back, comp, proj); // major note: NEVER forget to count FROM `first` and NOT implicitly from `0`!
+   case NINTHER:
+   {
+      RandomIt middle = first + n / 2;
+      if (n < NINTHER_THRESHOLD)
+         return chooseMedianOfThree(first, middle, back, comp, proj);
+
+      // The median of the medians of three samples of three, from the start, the middle and the end of the range
+      int step = n / 8;
+      return chooseMedianOfThree(chooseMedianOfThree(first, first + step, first + 2 * step, comp, proj),
+                                 chooseMedianOfThree(middle - step, middle, middle + step, comp, proj),
+                                 chooseMedianOfThree(back - 2 * step, back - step, back, comp, proj), comp, proj);
+   }
    case FIRST:
    default:
-      pivot_initial = start;
-      break;
+      return first;
    }
+}
 
-   // Preprocess step: ensure that no matter which pivot element was picked, that it is placed at the start of the array; this is a no-op if pivot = start
-   swap(v[start], v[pivot_initial]);
-
-   // Partition around the pivot
-   int j = start + 1; // marks the frontier between the partitioned section and the unpartitioned section
-   int i = j;         // marks the frontier between the smaller elements and the larger elements, within the partitioned section
-   while (j < end)
+// Partitions [first, last) around the pivot at *first, comparing it with each of the other elements once, and returns
+// where the pivot ends up: the elements before it are less than it, and the ones after it are not
+template <typename RandomIt, typename Compare, typename Projection>
+RandomIt partitionAroundFirst(RandomIt first, RandomIt last, Compare &comp, Projection &proj)
+{
+   RandomIt j = first + 1; // marks the frontier between the partitioned section and the unpartitioned section
+   RandomIt i = j;         // marks the frontier between the smaller elements and the larger elements, within the partitioned section
+   while (j < last)
    {
-      if (v[j] < v[start])
+      if (comp(proj(*j), proj(*first)))
       {
-         swap(v[i], v[j]);
+         iter_swap(i, j);
          ++i;
       }
 
       ++j;
    }
-   int pivot = i - 1;        // finally, identify the final location of the pivot...
-   swap(v[start], v[pivot]); // ...and place it where it belongs
+   RandomIt pivot = i - 1;    // finally, identify the final location of the pivot...
+   iter_swap(first, pivot); // ...and place it where it belongs
+   return pivot;
+}
+
+// Sorts [first, last) by comp on the projections of the elements, returning the number of comparisons, e.g.
+//    quickSort(records.begin(), records.end(), MEDIAN, less<>(), [](Record const &r) { return r.key; });
+template <typename RandomIt, typename Compare = less<>, typename Projection = Identity>
+int quickSort(RandomIt first, RandomIt last, ChoiceOfPivot const pivotChoice, Compare comp = Compare(), Projection proj = Projection())
+{
+   int n = last - first;
+
+   if (n < 2)
+      return 0;
+
+   // Select the pivot
+   RandomIt pivot_initial = choosePivot(first, last, pivotChoice, comp, proj);
+
+   // Preprocess step: ensure that no matter which pivot element was picked, that it is placed at the start of the array; this is a no-op if pivot = first
+   iter_swap(first, pivot_initial);
+
+   // Partition around the pivot
+   RandomIt pivot = partitionAroundFirst(first, last, comp, proj);
 
    // Recurse into both sides of the pivot
-   return n - 1                                        // always doing comparisons equal to one less than the size of the array, see partition implementation above
-          + quickSort(start, pivot, v, pivotChoice)    // before the pivot
-          + quickSort(pivot + 1, end, v, pivotChoice); // after the pivot
+   return n - 1                                                       // always doing comparisons equal to one less than the size of the array, see partition implementation above
+          + quickSort(first, pivot, pivotChoice, comp, proj)          // before the pivot
+          + quickSort(pivot + 1, last, pivotChoice, comp, proj);      // after the pivot
+}
+
+int quickSort(int start, int end, vector<int> &v, ChoiceOfPivot const pivotChoice) // start is inclusive but end is EXCLUSIVE
+{
+   return quickSort(v.begin() + start, v.begin() + end, pivotChoice);
 }
 
 int quickSort(vector<int> &v, ChoiceOfPivot const pivotChoice)
@@ -120,6 +180,805 @@ int quickSort(vector<int> &v, ChoiceOfPivot const pivotChoice)
    return quickSort(0, v.size(), v, pivotChoice);
 }
 
+#pragma region Introsort
+// Production mode: introsort, which sorts like quickSort() but cannot go quadratic, does not count comparisons, and
+// handles ranges small enough that recursing into them costs more than it saves with insertion sort
+
+// Ranges up to this size are left to insertion sort
+int const INSERTION_SORT_CUTOFF = 32;
+
+template <typename RandomIt, typename Compare, typename Projection>
+void insertionSort(RandomIt first, RandomIt last, Compare &comp, Projection &proj)
+{
+   if (first == last)
+      return;
+
+   for (RandomIt i = first + 1; i < last; ++i)
+   {
+      auto x = move(*i);
+      RandomIt j = i;
+      for (; j > first && comp(proj(x), proj(*(j - 1))); --j)
+         *j = move(*(j - 1));
+      *j = move(x);
+   }
+}
+
+// Moves the element at first[root] down the max-heap first[0..n) until neither child is greater than it
+template <typename RandomIt, typename Compare, typename Projection>
+void siftDown(RandomIt first, int root, int n, Compare &comp, Projection &proj)
+{
+   for (int child = 2 * root + 1; child < n; root = child, child = 2 * root + 1)
+   {
+      if (child + 1 < n && comp(proj(first[child]), proj(first[child + 1])))
+         ++child;
+      if (!comp(proj(first[root]), proj(first[child])))
+         return;
+      iter_swap(first + root, first + child);
+   }
+}
+
+// In-place heapsort, the O(n log n) fallback for ranges on which the quicksort recursion went too deep
+template <typename RandomIt, typename Compare, typename Projection>
+void heapSortInPlace(RandomIt first, RandomIt last, Compare &comp, Projection &proj)
+{
+   int n = last - first;
+   for (int root = n / 2 - 1; root >= 0; --root)
+      siftDown(first, root, n, comp, proj);
+   for (int end = n - 1; end > 0; --end)
+   {
+      iter_swap(first, first + end);
+      siftDown(first, 0, end, comp, proj);
+   }
+}
+
+// Partitions [first, last) around the pivot at *first into [first, equal) < pivot, [equal, greater) == pivot and
+// [greater, last) > pivot, so that runs of equal elements are finished in one go, and returns {equal, greater}
+template <typename RandomIt, typename Compare, typename Projection>
+pair<RandomIt, RandomIt> partitionThreeWay(RandomIt first, RandomIt last, Compare &comp, Projection &proj)
+{
+   // Dutch flag partition around a copy of the pivot, with [i, greater) not looked at yet
+   auto const pivot = *first;
+   RandomIt equal = first, i = first + 1, greater = last;
+   while (i < greater)
+   {
+      if (comp(proj(*i), proj(pivot)))
+         iter_swap(equal++, i++);
+      else if (comp(proj(pivot), proj(*i)))
+         iter_swap(i, --greater);
+      else
+         ++i;
+   }
+   return {equal, greater};
+}
+
+// Number of elements the block partition classifies at a time on each side
+int const PARTITION_BLOCK = 64;
+
+// Partitions [first, last) around the pivot at *first into elements less than it, the pivot, and elements not less than
+// it, and returns where the pivot ends up along with whether the range was already partitioned. This is Hoare's partition
+// without the branch on every comparison, which mispredicts half the time on random input: each side classifies a block
+// of elements at a time, recording the offsets of the misplaced ones with no branch but the loop's, and then the
+// misplaced elements of the two sides are swapped in a batch. The last couple of blocks go through the plain loop
+template <typename RandomIt, typename Compare, typename Projection>
+pair<RandomIt, bool> partitionBlocks(RandomIt first, RandomIt last, Compare &comp, Projection &proj)
+{
+   auto const pivot = *first;
+   RandomIt left = first + 1, right = last; // [first + 1, left) < pivot and [right, last) >= pivot
+   unsigned char offsets_left[PARTITION_BLOCK], offsets_right[PARTITION_BLOCK];
+   int n_left = 0, n_right = 0, start_left = 0, start_right = 0;
+   bool partitioned = true;
+
+   while (right - left > 2 * PARTITION_BLOCK)
+   {
+      if (n_left == 0)
+      {
+         start_left = 0;
+         for (int i = 0; i < PARTITION_BLOCK; ++i)
+         {
+            offsets_left[n_left] = i;
+            n_left += !comp(proj(left[i]), proj(pivot));
+         }
+      }
+      if (n_right == 0)
+      {
+         start_right = 0;
+         for (int i = 0; i < PARTITION_BLOCK; ++i)
+         {
+            offsets_right[n_right] = i;
+            n_right += comp(proj(*(right - 1 - i)), proj(pivot));
+         }
+      }
+
+      int n_swaps = min(n_left, n_right);
+      for (int k = 0; k < n_swaps; ++k)
+         iter_swap(left + offsets_left[start_left + k], right - 1 - offsets_right[start_right + k]);
+      partitioned = partitioned && n_swaps == 0;
+      n_left -= n_swaps;
+      n_right -= n_swaps;
+      start_left += n_swaps;
+      start_right += n_swaps;
+
+      // A side moves on once its block holds no misplaced elements; the other keeps its offsets for the next round
+      if (n_left == 0)
+         left += PARTITION_BLOCK;
+      if (n_right == 0)
+         right -= PARTITION_BLOCK;
+   }
+
+   // What is left, including a block with misplaced elements still pending, is at most three blocks long
+   for (;;)
+   {
+      for (; left < right && comp(proj(*left), proj(pivot)); ++left)
+         ;
+      for (; left < right && !comp(proj(*(right - 1)), proj(pivot)); --right)
+         ;
+      if (left == right)
+         break;
+      iter_swap(left++, --right);
+      partitioned = false;
+   }
+
+   RandomIt pivot_final = left - 1;
+   iter_swap(first, pivot_final);
+   return {pivot_final, partitioned};
+}
+
+// Most element moves partialInsertionSort() makes before giving up
+int const PARTIAL_INSERTION_LIMIT = 8;
+
+// Insertion sort that gives up once it has moved elements more than PARTIAL_INSERTION_LIMIT places in total, returning
+// whether it finished; cheap on ranges that are already sorted or nearly so
+template <typename RandomIt, typename Compare, typename Projection>
+bool partialInsertionSort(RandomIt first, RandomIt last, Compare &comp, Projection &proj)
+{
+   if (first == last)
+      return true;
+
+   int moves = 0;
+   for (RandomIt i = first + 1; i < last; ++i)
+   {
+      if (!comp(proj(*i), proj(*(i - 1))))
+         continue;
+
+      auto x = move(*i);
+      RandomIt j = i;
+      for (; j > first && comp(proj(x), proj(*(j - 1))); --j)
+         *j = move(*(j - 1));
+      *j = move(x);
+
+      moves += i - j;
+      if (moves > PARTIAL_INSERTION_LIMIT)
+         return false;
+   }
+   return true;
+}
+
+// Sorts [first, last) with quicksort on block partitions, guarding against the patterns that defeat it the way pdqsort
+// does. leftmost tells whether [first, last) starts the whole range; if not, the element before it is no greater than
+// any element in it
+template <typename RandomIt, typename Compare, typename Projection>
+void introSortLoop(RandomIt first, RandomIt last, ChoiceOfPivot const pivotChoice, int depth_limit, bool leftmost, Compare &comp, Projection &proj)
+{
+   while (last - first > INSERTION_SORT_CUTOFF)
+   {
+      if (depth_limit-- == 0)
+      {
+         heapSortInPlace(first, last, comp, proj);
+         return;
+      }
+
+      int n = last - first;
+      iter_swap(first, choosePivot(first, last, pivotChoice, comp, proj));
+
+      // A pivot equal to the element before the range means the range holds many copies of it, since that element was a
+      // pivot not long ago; the three-way partition finishes all of them at once and leaves only greater elements
+      if (!leftmost && !comp(proj(*(first - 1)), proj(*first)))
+      {
+         first = partitionThreeWay(first, last, comp, proj).second;
+         continue;
+      }
+
+      auto partition = partitionBlocks(first, last, comp, proj);
+      RandomIt pivot = partition.first;
+      int n_less = pivot - first, n_greater = last - pivot - 1;
+
+      // A very unbalanced partition hints at a pattern in the input that fools the pivot choice, so break it up by
+      // swapping a few elements around. A balanced one that needed no swaps hints at sorted input, so try to finish
+      // both sides with an insertion sort that gives up quickly if they are not nearly sorted after all
+      if (min(n_less, n_greater) < n / 8)
+      {
+         if (n_less >= INSERTION_SORT_CUTOFF)
+         {
+            iter_swap(first, first + n_less / 4);
+            iter_swap(pivot - 1, pivot - n_less / 4);
+         }
+         if (n_greater >= INSERTION_SORT_CUTOFF)
+         {
+            iter_swap(pivot + 1, pivot + 1 + n_greater / 4);
+            iter_swap(last - 1, last - n_greater / 4);
+         }
+      }
+      else if (partition.second && partialInsertionSort(first, pivot, comp, proj) && partialInsertionSort(pivot + 1, last, comp, proj))
+         return;
+
+      // Recurse into the smaller side and loop on the larger one, so that the stack stays O(log n) deep
+      if (n_less < n_greater)
+      {
+         introSortLoop(first, pivot, pivotChoice, depth_limit, leftmost, comp, proj);
+         first = pivot + 1;
+         leftmost = false;
+      }
+      else
+      {
+         introSortLoop(pivot + 1, last, pivotChoice, depth_limit, false, comp, proj);
+         last = pivot;
+      }
+   }
+
+   insertionSort(first, last, comp, proj);
+}
+
+// Sorts [first, last) by comp on the projections of the elements, falling back to heapsort once the partitions are
+// 2 log n deep, so that even FIRST or LAST pivots on sorted input stay O(n log n). The default ninther pivot with the
+// pattern checks in introSortLoop() sorts already sorted, reversed and few-distinct inputs in about linear time
+template <typename RandomIt, typename Compare = less<>, typename Projection = Identity>
+void introSort(RandomIt first, RandomIt last, ChoiceOfPivot const pivotChoice = NINTHER, Compare comp = Compare(), Projection proj = Projection())
+{
+   int n = last - first;
+   if (n < 2)
+      return;
+
+   introSortLoop(first, last, pivotChoice, 2 * int(log2(n)), true, comp, proj);
+}
+
+void introSort(vector<int> &v, ChoiceOfPivot const pivotChoice = NINTHER)
+{
+   introSort(v.begin(), v.end(), pivotChoice);
+}
+#pragma endregion
+
+
+#pragma region Parallel
+// Fixed-size pool of worker threads, each with its own task deque. Workers push and pop their own tasks at the back
+// (LIFO, which keeps a divide-and-conquer recursion depth-first and cache-friendly) and steal from the front of the
+// other deques when they run dry. Threads outside the pool submit to a shared deque, which workers also steal from
+class ThreadPool
+{
+   struct Queue
+   {
+      mutex lock;
+      deque<function<void()>> tasks;
+   };
+   vector<unique_ptr<Queue>> queues; // one per worker, then the shared one
+   vector<thread> workers;
+   atomic<bool> stopping{false};
+   atomic<int> queued{0};
+   mutex sleep_lock;
+   condition_variable wake;
+
+   static thread_local ThreadPool *current_pool;
+   static thread_local int current_index;
+
+   void WorkerLoop(int index)
+   {
+      current_pool = this;
+      current_index = index;
+      while (!stopping)
+      {
+         if (TryRunOne())
+            continue;
+         unique_lock<mutex> lock(sleep_lock);
+         wake.wait(lock, [this]() { return stopping || queued > 0; });
+      }
+   }
+
+public:
+   // The calling thread counts towards the thread count, since it runs tasks too while it waits on a TaskGroup
+   explicit ThreadPool(int threads)
+   {
+      int n_workers = max(threads, 1) - 1;
+      for (int i = 0; i <= n_workers; ++i)
+         queues.push_back(make_unique<Queue>());
+      for (int i = 0; i < n_workers; ++i)
+         workers.emplace_back([this, i]() { WorkerLoop(i); });
+   }
+
+   ~ThreadPool()
+   {
+      {
+         lock_guard<mutex> lock(sleep_lock);
+         stopping = true;
+      }
+      wake.notify_all();
+      for (thread &worker : workers)
+         worker.join();
+   }
+
+   int size() const
+   {
+      return workers.size() + 1;
+   }
+
+   // Index in [0, size()) of the calling thread: its worker number, or size() - 1 for a thread outside the pool
+   int ThreadIndex() const
+   {
+      return current_pool == this ? current_index : int(workers.size());
+   }
+
+   void Submit(function<void()> task)
+   {
+      Queue &queue = *queues[ThreadIndex()];
+      {
+         lock_guard<mutex> lock(queue.lock);
+         queue.tasks.push_back(move(task));
+      }
+      ++queued;
+      // Taking the sleep lock orders this submission before any worker's next check of the wait condition, so no wakeup is lost
+      {
+         lock_guard<mutex> lock(sleep_lock);
+      }
+      wake.notify_one();
+   }
+
+   // Runs one queued task, preferring the newest task of this thread's own deque, then the oldest task of any other deque
+   bool TryRunOne()
+   {
+      int n = queues.size();
+      int own = ThreadIndex();
+      function<void()> task;
+      for (int i = 0; i < n && !task; ++i)
+      {
+         Queue &queue = *queues[(own + i) % n];
+         lock_guard<mutex> lock(queue.lock);
+         if (queue.tasks.empty())
+            continue;
+         if (i == 0)
+         {
+            task = move(queue.tasks.back());
+            queue.tasks.pop_back();
+         }
+         else
+         {
+            task = move(queue.tasks.front());
+            queue.tasks.pop_front();
+         }
+      }
+      if (!task)
+         return false;
+
+      --queued;
+      task();
+      return true;
+   }
+};
+
+thread_local ThreadPool *ThreadPool::current_pool = nullptr;
+thread_local int ThreadPool::current_index = 0;
+
+// Fork-join helper: tasks forked with Run() are all finished once Wait() returns
+class TaskGroup
+{
+   ThreadPool &pool;
+   atomic<int> pending{0};
+
+public:
+   TaskGroup(ThreadPool &_pool) : pool(_pool)
+   { /* nothing */ }
+
+   ~TaskGroup()
+   {
+      Wait();
+   }
+
+   void Run(function<void()> task)
+   {
+      ++pending;
+      pool.Submit([this, task]() {
+         task();
+         --pending;
+      });
+   }
+
+   // Runs queued tasks while waiting rather than blocking, so a task waiting on its children never starves the pool
+   void Wait()
+   {
+      while (pending > 0)
+         if (!pool.TryRunOne())
+            this_thread::yield();
+   }
+};
+
+struct ParallelSortOptions
+{
+   int grain = 1 << 14;              // ranges shorter than this are sorted by a single task with quickSort()
+   int partition_levels = 2;         // number of levels of the recursion, from the top, whose partitions may be split across the pool
+   int partition_min_length = 1 << 20; // ranges shorter than this are partitioned by a single thread even in those levels
+};
+
+// Comparison count of one thread, on a cache line of its own so that the threads do not contend for it
+struct alignas(64) ComparisonCounter
+{
+   int64_t count = 0;
+};
+
+// Partitions [first, last) around the pivot at *first like partitionAroundFirst(), on every thread of the pool: each
+// thread partitions a piece of the range on its own, which leaves the elements less than the pivot that sit after where
+// the boundary belongs matched one for one with the other elements before it, and then the threads swap those pairs,
+// an equal share each. The arrangement of each side differs from that of partitionAroundFirst()
+template <typename RandomIt, typename Compare, typename Projection>
+RandomIt partitionParallel(RandomIt first, RandomIt last, ThreadPool &pool, Compare &comp, Projection &proj)
+{
+   auto const pivot = *first;
+   RandomIt begin = first + 1;
+   int n = last - begin, pieces = pool.size();
+   vector<int> bounds(pieces + 1), n_less(pieces);
+   for (int t = 0; t <= pieces; ++t)
+      bounds[t] = int64_t(n) * t / pieces;
+
+   {
+      TaskGroup group(pool);
+      for (int t = 0; t < pieces; ++t)
+         group.Run([&, t]() {
+            RandomIt piece = begin + bounds[t];
+            n_less[t] = partition(piece, begin + bounds[t + 1], [&](auto const &x) { return comp(proj(x), proj(pivot)); }) - piece;
+         });
+   }
+
+   // Each piece is now [less than the pivot | the rest]; the boundary belongs at the total count of the lesser elements.
+   // Gather the stretches of elements on the wrong side of it, which add up to the same length on both sides
+   int boundary = 0;
+   for (int t = 0; t < pieces; ++t)
+      boundary += n_less[t];
+   vector<pair<int, int>> wrong_before, wrong_after; // [start, end) of each stretch, relative to begin
+   int n_wrong = 0;
+   for (int t = 0; t < pieces; ++t)
+   {
+      int split = bounds[t] + n_less[t];
+      if (split < boundary && split < bounds[t + 1])
+      {
+         wrong_before.push_back({split, min(bounds[t + 1], boundary)});
+         n_wrong += wrong_before.back().second - wrong_before.back().first;
+      }
+      if (split > boundary && bounds[t] < split)
+         wrong_after.push_back({max(bounds[t], boundary), split});
+   }
+
+   // Position, relative to begin, of the k-th element of the stretches
+   auto locate = [](vector<pair<int, int>> const &stretches, int k) {
+      size_t s = 0;
+      for (; k >= stretches[s].second - stretches[s].first; ++s)
+         k -= stretches[s].second - stretches[s].first;
+      return make_pair(s, stretches[s].first + k);
+   };
+
+   {
+      TaskGroup group(pool);
+      for (int t = 0; t < pieces; ++t)
+      {
+         int k_start = int64_t(n_wrong) * t / pieces, k_end = int64_t(n_wrong) * (t + 1) / pieces;
+         if (k_start == k_end)
+            continue;
+         group.Run([&, k_start, k_end]() {
+            auto before = locate(wrong_before, k_start), after = locate(wrong_after, k_start);
+            for (int k = k_start; k < k_end; ++k)
+            {
+               if (before.second == wrong_before[before.first].second)
+                  before = {before.first + 1, wrong_before[before.first + 1].first};
+               if (after.second == wrong_after[after.first].second)
+                  after = {after.first + 1, wrong_after[after.first + 1].first};
+               iter_swap(begin + before.second++, begin + after.second++);
+            }
+         });
+      }
+   }
+
+   RandomIt pivot_final = begin + boundary - 1;
+   iter_swap(first, pivot_final);
+   return pivot_final;
+}
+
+template <typename RandomIt, typename Compare, typename Projection>
+void quickSortTask(RandomIt first, RandomIt last, ChoiceOfPivot const pivotChoice, int level, ThreadPool &pool, TaskGroup &group,
+                   vector<ComparisonCounter> &counters, ParallelSortOptions const &options, Compare &comp, Projection &proj)
+{
+   // Fork the part before the pivot as a task and carry on with the part after it
+   for (; last - first >= options.grain; ++level)
+   {
+      int n = last - first;
+      iter_swap(first, choosePivot(first, last, pivotChoice, comp, proj));
+      RandomIt pivot = level < options.partition_levels && n >= options.partition_min_length ? partitionParallel(first, last, pool, comp, proj)
+                                                                                             : partitionAroundFirst(first, last, comp, proj);
+      counters[pool.ThreadIndex()].count += n - 1;
+
+      group.Run([=, &pool, &group, &counters, &options, &comp, &proj]() {
+         quickSortTask(first, pivot, pivotChoice, level + 1, pool, group, counters, options, comp, proj);
+      });
+      first = pivot + 1;
+   }
+
+   counters[pool.ThreadIndex()].count += quickSort(first, last, pivotChoice, comp, proj);
+}
+
+// Sorts [first, last) like quickSort() on the threads of pool, returning the number of comparisons. Ranges of at least
+// options.grain elements are partitioned and their two sides handed to the pool as separate tasks, and each thread adds
+// up the comparisons of the partitions it runs in a counter of its own; the counters are summed once the sort is done.
+// Without parallel partitions (options.partition_levels = 0) the count is exactly that of quickSort(), whatever the
+// number of threads. comp and proj are called from several threads at once, and only one thread outside the pool may
+// sort on it at a time
+template <typename RandomIt, typename Compare = less<>, typename Projection = Identity>
+int quickSortParallel(RandomIt first, RandomIt last, ChoiceOfPivot const pivotChoice, ThreadPool &pool,
+                      ParallelSortOptions const &options = ParallelSortOptions(), Compare comp = Compare(), Projection proj = Projection())
+{
+   vector<ComparisonCounter> counters(pool.size());
+   {
+      TaskGroup group(pool);
+      quickSortTask(first, last, pivotChoice, 0, pool, group, counters, options, comp, proj);
+   }
+
+   int64_t comparisons = 0;
+   for (ComparisonCounter const &counter : counters)
+      comparisons += counter.count;
+   return comparisons;
+}
+
+int quickSortParallel(vector<int> &v, ChoiceOfPivot const pivotChoice, ThreadPool &pool, ParallelSortOptions const &options = ParallelSortOptions())
+{
+   return quickSortParallel(v.begin(), v.end(), pivotChoice, pool, options);
+}
+#pragma endregion
+
+#pragma region Pivot strategies
+// Pivot selection as a pluggable policy: an object with operator()(first, last, comp, proj) that returns the element of
+// the non-empty range [first, last) to partition around, and Name() for reports. It may reorder the range
+
+// One of the fixed choices of quickSort()
+struct FixedPivot
+{
+   ChoiceOfPivot choice;
+
+   FixedPivot(ChoiceOfPivot _choice) : choice(_choice)
+   { /* nothing */ }
+
+   string Name() const
+   {
+      switch (choice)
+      {
+      case LAST:
+         return "last";
+      case MEDIAN:
+         return "median-of-3";
+      case NINTHER:
+         return "ninther";
+      case FIRST:
+      default:
+         return "first";
+      }
+   }
+
+   template <typename RandomIt, typename Compare, typename Projection>
+   RandomIt operator()(RandomIt first, RandomIt last, Compare &comp, Projection &proj)
+   {
+      return choosePivot(first, last, choice, comp, proj);
+   }
+};
+
+// A uniformly random element
+struct RandomPivot
+{
+   mt19937 rng;
+
+   RandomPivot(unsigned _seed = 24) : rng(_seed)
+   { /* nothing */ }
+
+   string Name() const
+   {
+      return "random";
+   }
+
+   template <typename RandomIt, typename Compare, typename Projection>
+   RandomIt operator()(RandomIt first, RandomIt last, Compare &, Projection &)
+   {
+      return first + uniform_int_distribution<int>(0, last - first - 1)(rng);
+   }
+};
+
+// The median of samples elements spread evenly over the range, or of the whole range if it is shorter
+struct SampledPivot
+{
+   int samples;
+
+   SampledPivot(int _samples = 31) : samples(_samples)
+   { /* nothing */ }
+
+   string Name() const
+   {
+      return "sampled-" + to_string(samples);
+   }
+
+   template <typename RandomIt, typename Compare, typename Projection>
+   RandomIt operator()(RandomIt first, RandomIt last, Compare &comp, Projection &proj)
+   {
+      int n = last - first, k = min(n, samples);
+      vector<RandomIt> candidates(k);
+      for (int i = 0; i < k; ++i)
+         candidates[i] = first + (int64_t(2 * i + 1) * n) / (2 * k);
+      sort(candidates.begin(), candidates.end(), [&](RandomIt x, RandomIt y) { return comp(proj(*x), proj(*y)); });
+      return candidates[(k - 1) / 2];
+   }
+};
+
+template <typename RandomIt, typename Compare, typename Projection>
+RandomIt medianOfMedians(RandomIt first, RandomIt last, Compare &comp, Projection &proj);
+
+// Puts the k-th smallest element of [first, last) at first + k, with no greater elements before it and no lesser ones
+// after it, in worst-case linear time (Blum, Floyd, Pratt, Rivest and Tarjan)
+template <typename RandomIt, typename Compare, typename Projection>
+void selectMedianOfMedians(RandomIt first, RandomIt last, int k, Compare &comp, Projection &proj)
+{
+   while (last - first > 5)
+   {
+      iter_swap(first, medianOfMedians(first, last, comp, proj));
+      auto sides = partitionThreeWay(first, last, comp, proj);
+      if (k < sides.first - first)
+         last = sides.first;
+      else if (k < sides.second - first)
+         return;
+      else
+      {
+         k -= sides.second - first;
+         first = sides.second;
+      }
+   }
+   insertionSort(first, last, comp, proj);
+}
+
+// The median of the medians of groups of five, which has at least 3/10 of the range on either side of it. The medians
+// are gathered at the front of the range and the median among them selected there
+template <typename RandomIt, typename Compare, typename Projection>
+RandomIt medianOfMedians(RandomIt first, RandomIt last, Compare &comp, Projection &proj)
+{
+   int n = last - first, groups = 0;
+   for (int start = 0; start < n; start += 5, ++groups)
+   {
+      RandomIt group = first + start, group_end = first + min(start + 5, n);
+      insertionSort(group, group_end, comp, proj);
+      iter_swap(first + groups, group + (group_end - group - 1) / 2);
+   }
+   if (groups == 1)
+      return first;
+
+   selectMedianOfMedians(first, first + groups, (groups - 1) / 2, comp, proj);
+   return first + (groups - 1) / 2;
+}
+
+// The median of medians of groups of five: slow to compute, but never a bad pivot
+struct MedianOfMediansPivot
+{
+   string Name() const
+   {
+      return "median-of-medians";
+   }
+
+   template <typename RandomIt, typename Compare, typename Projection>
+   RandomIt operator()(RandomIt first, RandomIt last, Compare &comp, Projection &proj)
+   {
+      return medianOfMedians(first, last, comp, proj);
+   }
+};
+
+// What a sort with a given pivot strategy did: every comparison, the pivot selection's included, every swap the
+// partitions made, how many partitions ran at each depth of the recursion, and how lopsided they were
+struct SortProfile
+{
+   string strategy;
+   int64_t comparisons = 0;
+   int64_t swaps = 0;
+   int64_t partitions = 0;
+   vector<int64_t> partitions_at_depth;
+   double total_imbalance = 0; // sum over the partitions of |less - greater| / size, 0 for an even split, 1 for a one-sided one
+   double milliseconds = 0;
+
+   int MaxDepth() const
+   {
+      return partitions_at_depth.size();
+   }
+
+   double MeanImbalance() const
+   {
+      return partitions == 0 ? 0 : total_imbalance / partitions;
+   }
+};
+
+ostream &operator<<(ostream &os, SortProfile const &profile)
+{
+   os << profile.strategy << ": " << profile.comparisons << " comparisons, " << profile.swaps << " swaps, " << profile.partitions
+      << " partitions, max depth " << profile.MaxDepth() << ", mean imbalance " << profile.MeanImbalance() << ", " << profile.milliseconds << " ms";
+   return os;
+}
+
+template <typename RandomIt, typename PivotPolicy, typename Compare, typename Projection>
+void quickSortProfiledLoop(RandomIt first, RandomIt last, int depth, PivotPolicy &choose_pivot, SortProfile &profile, Compare &comp, Projection &proj)
+{
+   for (; last - first > 1; ++depth)
+   {
+      int n = last - first;
+      iter_swap(first, choose_pivot(first, last, comp, proj));
+      auto sides = partitionThreeWay(first, last, comp, proj);
+      int n_less = sides.first - first, n_greater = last - sides.second;
+
+      // The three-way partition swaps each lesser and each greater element once, after the swap that brought the pivot to the front
+      profile.swaps += 1 + n_less + n_greater;
+      ++profile.partitions;
+      if (profile.partitions_at_depth.size() <= depth)
+         profile.partitions_at_depth.resize(depth + 1);
+      ++profile.partitions_at_depth[depth];
+      profile.total_imbalance += double(abs(n_less - n_greater)) / n;
+
+      // Recurse into the smaller side and loop on the larger one, both a level deeper
+      if (n_less < n_greater)
+      {
+         quickSortProfiledLoop(first, sides.first, depth + 1, choose_pivot, profile, comp, proj);
+         first = sides.second;
+      }
+      else
+      {
+         quickSortProfiledLoop(sides.second, last, depth + 1, choose_pivot, profile, comp, proj);
+         last = sides.first;
+      }
+   }
+}
+
+// Sorts [first, last) by comp on the projections of the elements with a quicksort that picks pivots with choose_pivot
+// and partitions three ways, and returns its profile, e.g.
+//    cout << quickSortProfiled(v.begin(), v.end(), MedianOfMediansPivot()) << endl;
+template <typename RandomIt, typename PivotPolicy, typename Compare = less<>, typename Projection = Identity>
+SortProfile quickSortProfiled(RandomIt first, RandomIt last, PivotPolicy choose_pivot, Compare comp = Compare(), Projection proj = Projection())
+{
+   SortProfile profile;
+   profile.strategy = choose_pivot.Name();
+   auto counting_comp = [&](auto const &a, auto const &b) {
+      ++profile.comparisons;
+      return comp(a, b);
+   };
+
+   auto start = chrono::steady_clock::now();
+   quickSortProfiledLoop(first, last, 0, choose_pivot, profile, counting_comp, proj);
+   auto end = chrono::steady_clock::now();
+   profile.milliseconds = chrono::duration<double, milli>(end - start).count();
+   return profile;
+}
+#pragma endregion
+
+// Moves the elements of [first, first + order.size()) so that element order[i].second comes i-th
+template <typename RandomIt, typename Key>
+void applyOrder(RandomIt first, vector<pair<Key, int>> const &order)
+{
+   vector<typename iterator_traits<RandomIt>::value_type> sorted;
+   sorted.reserve(order.size());
+   for (auto const &entry : order)
+      sorted.push_back(move(first[entry.second]));
+   move(sorted.begin(), sorted.end(), first);
+}
+
+// Key-value mode: sorts [first, last) by comp on key(element), for elements that are expensive to move, returning the
+// number of comparisons. Only (key, index) pairs are moved while sorting, and then every element is moved once to its
+// place. Equal keys are ordered by index, so unlike the plain quickSort() this is stable
+template <typename RandomIt, typename KeyFunction, typename Compare = less<>>
+int quickSortByKey(RandomIt first, RandomIt last, KeyFunction key, ChoiceOfPivot const pivotChoice, Compare comp = Compare())
+{
+   typedef decay_t<decltype(key(*first))> Key;
+   vector<pair<Key, int>> order;
+   order.reserve(last - first);
+   for (RandomIt it = first; it != last; ++it)
+      order.push_back({key(*it), int(it - first)});
+
+   int comparisons = quickSort(order.begin(), order.end(), pivotChoice, [&](pair<Key, int> const &a, pair<Key, int> const &b) {
+      return comp(a.first, b.first) || (!comp(b.first, a.first) && a.second < b.second);
+   });
+   applyOrder(first, order);
+   return comparisons;
+}
+
 int main()
 {
    // Find all test case files (courtesy of https://stackoverflow.com/a/612176/3477043)
@@ -144,12 +1003,48 @@ int main()
    // Sort them
    sort(test_case_files.begin(), test_case_files.end());
 
+   // Records sorted through the generic API, by a projected key and in key-value mode, checked against std::stable_sort
+   {
+      struct Record
+      {
+         int64_t key;
+         string payload;
+      };
+      mt19937 rng(15);
+      vector<Record> records;
+      for (int i = 0; i < 1000; ++i)
+         records.push_back({int64_t(rng() % 50) << 40, "record " + to_string(i)});
+      auto key = [](Record const &r) { return r.key; };
+      vector<Record> expected = records;
+      stable_sort(expected.begin(), expected.end(), [](Record const &a, Record const &b) { return a.key < b.key; });
+
+      bool success = true;
+      for (ChoiceOfPivot pivotChoice : {FIRST, LAST, MEDIAN, NINTHER})
+      {
+         vector<Record> projected = records, by_key = records, introsorted = records;
+         quickSort(projected.begin(), projected.end(), pivotChoice, less<>(), key);
+         quickSortByKey(by_key.begin(), by_key.end(), key, pivotChoice);
+         introSort(introsorted.begin(), introsorted.end(), pivotChoice, less<>(), key);
+         for (int i = 0; i < records.size(); ++i)
+            success = success && projected[i].key == expected[i].key && by_key[i].key == expected[i].key && by_key[i].payload == expected[i].payload &&
+                      introsorted[i].key == expected[i].key;
+      }
+      cout << "Generic API;" << (success ? "records sorted by key and in key-value mode" : "(FAILED!)") << endl;
+   }
+
    // For each case, read the file and sort the input integers while computing the number of comparisons
    vector<pair<ChoiceOfPivot, string>> problems = {
        {ChoiceOfPivot::FIRST, "First"},
        {ChoiceOfPivot::LAST, "Last"},
        {ChoiceOfPivot::MEDIAN, "Median-of-Three"},
+       {ChoiceOfPivot::NINTHER, "Ninther"},
    };
+   ThreadPool pool(4);
+   ParallelSortOptions whole_partitions, split_partitions;
+   whole_partitions.grain = split_partitions.grain = 16;
+   whole_partitions.partition_levels = 0;
+   split_partitions.partition_levels = 4;
+   split_partitions.partition_min_length = 64;
    int const n_start = 1, n = test_case_files.size();
    for (auto it = test_case_files.begin() + n_start - 1; it != test_case_files.begin() + n_start - 1 + n; ++it)
    {
@@ -174,8 +1069,159 @@ int main()
             cout << comparisons;
          cout << endl;
       }
+      cout << "Introsort;";
+      bool introSorted = true;
+      for (auto const &problem : problems)
+      {
+         auto sorted = test_case;
+         introSort(sorted, problem.first);
+         introSorted = introSorted && verify(sorted, test_case);
+      }
+      cout << (introSorted ? "sorted with every pivot choice" : "(FAILED!)") << endl;
+
+      // In parallel: the same count as sequentially when only whole partitions are handed out, and sorted output with
+      // split partitions as well
+      cout << "Parallel;";
+      bool parallelSorted = true;
+      for (auto const &problem : problems)
+      {
+         auto sorted = test_case, expected = test_case, split = test_case;
+         parallelSorted = parallelSorted && quickSortParallel(sorted, problem.first, pool, whole_partitions) == quickSort(expected, problem.first);
+         quickSortParallel(split, problem.first, pool, split_partitions);
+         parallelSorted = parallelSorted && verify(sorted, test_case) && verify(split, test_case);
+      }
+      cout << (parallelSorted ? "same comparisons as sequential with every pivot choice" : "(FAILED!)") << endl;
+
+      // With every pivot strategy
+      cout << "Pivot strategies;";
+      bool profiledSorted = true;
+      auto profileSorts = [&](auto choose_pivot) {
+         auto sorted = test_case;
+         quickSortProfiled(sorted.begin(), sorted.end(), choose_pivot);
+         profiledSorted = profiledSorted && verify(sorted, test_case);
+      };
+      profileSorts(RandomPivot());
+      profileSorts(FixedPivot(MEDIAN));
+      profileSorts(FixedPivot(NINTHER));
+      profileSorts(MedianOfMediansPivot());
+      profileSorts(SampledPivot());
+      cout << (profiledSorted ? "sorted with every strategy" : "(FAILED!)") << endl;
       cout << "; " << endl;
    }
 
+   // Introsort on every size up to a few partition blocks, with keys from all distinct to all equal, and with every pivot choice
+   {
+      mt19937 rng(22);
+      bool success = true;
+      for (int n = 0; n < 8 * PARTITION_BLOCK; ++n)
+         for (int distinct : {1, 3, 100, INT32_MAX})
+            for (auto const &problem : problems)
+            {
+               vector<int> v(n);
+               for (int &x : v)
+                  x = int(rng() % distinct);
+               auto sorted = v;
+               introSort(sorted, problem.first);
+               success = success && verify(sorted, v);
+            }
+      cout << "Introsort; " << (success ? "all sizes up to " + to_string(8 * PARTITION_BLOCK) + " sorted" : "(FAILED!)") << endl;
+   }
+
+   // Introsort timed against std::sort on inputs that are quadratic for quickSort() with some pivot choice: sorted,
+   // reversed, organ pipe, and only a few distinct values; the comparison counting mode would overflow the stack on them
+   {
+      mt19937 rng(21);
+      int n = 1 << 22;
+      vector<pair<string, vector<int>>> inputs = {{"random", vector<int>(n)}, {"sorted", vector<int>(n)}, {"reversed", vector<int>(n)},
+                                                   {"organ pipe", vector<int>(n)}, {"few distinct", vector<int>(n)}};
+      for (int i = 0; i < n; ++i)
+      {
+         inputs[0].second[i] = int(rng());
+         inputs[1].second[i] = i;
+         inputs[2].second[i] = n - i;
+         inputs[3].second[i] = min(i, n - i);
+         inputs[4].second[i] = int(rng() % 16);
+      }
+
+      for (auto const &input : inputs)
+      {
+         auto expected = input.second;
+         auto start = chrono::steady_clock::now();
+         sort(expected.begin(), expected.end());
+         auto end = chrono::steady_clock::now();
+         cout << "Introsort; " << input.first << ", " << n << " elements; std::sort " << chrono::duration<double, milli>(end - start).count() << " ms";
+
+         for (auto const &problem : problems)
+         {
+            auto sorted = input.second;
+            start = chrono::steady_clock::now();
+            introSort(sorted, problem.first);
+            end = chrono::steady_clock::now();
+            cout << ", " << problem.second << " " << (sorted == expected ? "" : "(FAILED!) ") << chrono::duration<double, milli>(end - start).count() << " ms";
+         }
+         cout << endl;
+      }
+   }
+
+   // A profile of every pivot strategy on inputs of various shapes, and the depth histogram of each on random input
+   {
+      mt19937 rng(24);
+      int n = 1 << 20;
+      vector<pair<string, vector<int>>> inputs = {{"random", vector<int>(n)}, {"sorted", vector<int>(n)}, {"reversed", vector<int>(n)},
+                                                   {"organ pipe", vector<int>(n)}, {"few distinct", vector<int>(n)}};
+      for (int i = 0; i < n; ++i)
+      {
+         inputs[0].second[i] = int(rng());
+         inputs[1].second[i] = i;
+         inputs[2].second[i] = n - i;
+         inputs[3].second[i] = min(i, n - i);
+         inputs[4].second[i] = int(rng() % 16);
+      }
+
+      for (auto const &input : inputs)
+      {
+         auto expected = input.second;
+         sort(expected.begin(), expected.end());
+         auto profile = [&](auto choose_pivot) {
+            auto sorted = input.second;
+            SortProfile result = quickSortProfiled(sorted.begin(), sorted.end(), choose_pivot);
+            cout << "Profile; " << input.first << ", " << n << " elements; " << (sorted == expected ? "" : "(FAILED!) ") << result << endl;
+            if (input.first == "random")
+               cout << "\tPartitions at each depth = " << result.partitions_at_depth << endl;
+         };
+         profile(RandomPivot());
+         profile(FixedPivot(MEDIAN));
+         profile(FixedPivot(NINTHER));
+         profile(MedianOfMediansPivot());
+         profile(SampledPivot());
+      }
+   }
+
+   // The parallel sort timed against the sequential one on random input, with any number of threads
+   {
+      mt19937 rng(23);
+      int n = 1 << 22;
+      vector<int> v(n);
+      for (int &x : v)
+         x = int(rng());
+
+      auto expected = v;
+      auto start = chrono::steady_clock::now();
+      int expected_comparisons = quickSort(expected, MEDIAN);
+      auto end = chrono::steady_clock::now();
+      cout << "Parallel; random, " << n << " elements; sequential " << expected_comparisons << " comparisons in " << chrono::duration<double, milli>(end - start).count() << " ms";
+
+      for (int threads : {1, 2, 4, 8})
+      {
+         ThreadPool threads_pool(threads);
+         auto sorted = v;
+         start = chrono::steady_clock::now();
+         int comparisons = quickSortParallel(sorted, MEDIAN, threads_pool);
+         end = chrono::steady_clock::now();
+         cout << ", " << threads << " threads " << (sorted == expected ? "" : "(FAILED!) ") << comparisons << " in " << chrono::duration<double, milli>(end - start).count() << " ms";
+      }
+      cout << endl;
+   }
+
    return 0;
 }
\ No newline at end of file
@@ -0,0 +1,444 @@
+/**
+ * Selection: find the k-th smallest element of an array (its k-th order statistic, counting from 0) without sorting it.
+ * Quickselect partitions around a pivot like QuickSort does, but only carries on into the side that holds position k, so
+ * it takes linear time on average. A randomized pivot makes that average hold for every input; switching to the median
+ * of medians of groups of five once the partitions stop shrinking the range fast enough makes it hold in the worst case.
+ * Several ranks can be selected at once by carrying on into every side that holds one of them.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <dirent.h> // UNIX only; for Windows, need to get it elsewhere, see https://stackoverflow.com/a/612176/3477043
+#include <string>
+
+#include <array>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <random>
+#include <chrono>
+#include <cassert>
+#include <cmath>
+
+using namespace std;
+
+#pragma region Utilities
+template <typename T>
+ostream &operator<<(ostream &os, vector<T> const &v)
+{
+   os << "[";
+   for (int i = 0; i < v.size(); ++i)
+   {
+      os << v[i];
+      if (i != v.size() - 1)
+         os << ", ";
+   }
+   os << "]";
+
+   return os;
+}
+
+// Whether the ranks of v hold the order statistics of original, with no greater elements before them and no lesser ones after
+bool verify(vector<int> const &v, vector<int> const &original, vector<int> const &ranks)
+{
+   vector<int> correctAnswer = original;
+   sort(correctAnswer.begin(), correctAnswer.end());
+
+   for (int k : ranks)
+   {
+      if (v[k] != correctAnswer[k])
+         return false;
+      for (int i = 0; i < v.size(); ++i)
+         if ((i < k && v[i] > v[k]) || (i > k && v[i] < v[k]))
+            return false;
+   }
+
+   return true;
+}
+#pragma endregion
+
+// Projection that leaves the elements as they are
+struct Identity
+{
+   template <typename T>
+   T &&operator()(T &&x) const
+   {
+      return forward<T>(x);
+   }
+};
+
+#pragma region Partition
+// Partitioning as in quicksort.cpp
+
+template <typename RandomIt, typename Compare, typename Projection>
+RandomIt chooseMedianOfThree(RandomIt a, RandomIt b, RandomIt c, Compare &comp, Projection &proj)
+{
+   array<RandomIt, 3> candidates = {a, b, c};
+   sort(candidates.begin(), candidates.end(), [&](RandomIt x, RandomIt y) { return comp(proj(*x), proj(*y)); });
+   return candidates[1]; // the median
+}
+
+// Ranges up to this size are left to insertion sort
+int const INSERTION_SORT_CUTOFF = 16;
+
+template <typename RandomIt, typename Compare, typename Projection>
+void insertionSort(RandomIt first, RandomIt last, Compare &comp, Projection &proj)
+{
+   if (first == last)
+      return;
+
+   for (RandomIt i = first + 1; i < last; ++i)
+   {
+      auto x = move(*i);
+      RandomIt j = i;
+      for (; j > first && comp(proj(x), proj(*(j - 1))); --j)
+         *j = move(*(j - 1));
+      *j = move(x);
+   }
+}
+
+// Partitions [first, last) around the pivot at *first into [first, equal) < pivot, [equal, greater) == pivot and
+// [greater, last) > pivot, so that runs of equal elements are finished in one go, and returns {equal, greater}
+template <typename RandomIt, typename Compare, typename Projection>
+pair<RandomIt, RandomIt> partitionThreeWay(RandomIt first, RandomIt last, Compare &comp, Projection &proj)
+{
+   // Dutch flag partition around a copy of the pivot, with [i, greater) not looked at yet
+   auto const pivot = *first;
+   RandomIt equal = first, i = first + 1, greater = last;
+   while (i < greater)
+   {
+      if (comp(proj(*i), proj(pivot)))
+         iter_swap(equal++, i++);
+      else if (comp(proj(pivot), proj(*i)))
+         iter_swap(i, --greater);
+      else
+         ++i;
+   }
+   return {equal, greater};
+}
+
+template <typename RandomIt, typename Compare, typename Projection>
+RandomIt medianOfMedians(RandomIt first, RandomIt last, Compare &comp, Projection &proj);
+
+// Puts the k-th smallest element of [first, last) at first + k, with no greater elements before it and no lesser ones
+// after it, in worst-case linear time (Blum, Floyd, Pratt, Rivest and Tarjan)
+template <typename RandomIt, typename Compare, typename Projection>
+void selectMedianOfMedians(RandomIt first, RandomIt last, int k, Compare &comp, Projection &proj)
+{
+   while (last - first > 5)
+   {
+      iter_swap(first, medianOfMedians(first, last, comp, proj));
+      auto sides = partitionThreeWay(first, last, comp, proj);
+      if (k < sides.first - first)
+         last = sides.first;
+      else if (k < sides.second - first)
+         return;
+      else
+      {
+         k -= sides.second - first;
+         first = sides.second;
+      }
+   }
+   insertionSort(first, last, comp, proj);
+}
+
+// The median of the medians of groups of five, which has at least 3/10 of the range on either side of it. The medians
+// are gathered at the front of the range and the median among them selected there
+template <typename RandomIt, typename Compare, typename Projection>
+RandomIt medianOfMedians(RandomIt first, RandomIt last, Compare &comp, Projection &proj)
+{
+   int n = last - first, groups = 0;
+   for (int start = 0; start < n; start += 5, ++groups)
+   {
+      RandomIt group = first + start, group_end = first + min(start + 5, n);
+      insertionSort(group, group_end, comp, proj);
+      iter_swap(first + groups, group + (group_end - group - 1) / 2);
+   }
+   if (groups == 1)
+      return first;
+
+   selectMedianOfMedians(first, first + groups, (groups - 1) / 2, comp, proj);
+   return first + (groups - 1) / 2;
+}
+#pragma endregion
+
+#pragma region Selection
+// Puts the k-th smallest element of [first, last) by comp on the projections of the elements at first + k, with no
+// greater elements before it and no lesser ones after it, and returns first + k. Pivots are uniformly random, so the
+// expected time is linear whatever the input
+template <typename RandomIt, typename Compare = less<>, typename Projection = Identity>
+RandomIt randomizedSelect(RandomIt first, RandomIt last, int k, mt19937 &rng, Compare comp = Compare(), Projection proj = Projection())
+{
+   assert(0 <= k && k < last - first);
+   RandomIt target = first + k;
+
+   while (last - first > INSERTION_SORT_CUTOFF)
+   {
+      iter_swap(first, first + uniform_int_distribution<int>(0, last - first - 1)(rng));
+      auto sides = partitionThreeWay(first, last, comp, proj);
+      if (target < sides.first)
+         last = sides.first;
+      else if (target < sides.second)
+         return target;
+      else
+         first = sides.second;
+   }
+
+   insertionSort(first, last, comp, proj);
+   return target;
+}
+
+// Most elements introSelect() partitions with median-of-three pivots, as a multiple of the length of the range, before it
+// takes medians of medians instead. Quickselect with median-of-three pivots partitions fewer than 3n elements on average
+int const INTROSELECT_WORK_FACTOR = 6;
+
+// Puts the k-th smallest element of [first, last) at first + k like randomizedSelect(), and returns first + k, in
+// worst-case linear time: pivots are medians of three, which are cheap and good on most inputs, until the partitions
+// have gone through INTROSELECT_WORK_FACTOR times the length of the range, a sign that the input defeats them, after
+// which the rest of the range is left to selectMedianOfMedians()
+template <typename RandomIt, typename Compare = less<>, typename Projection = Identity>
+RandomIt introSelect(RandomIt first, RandomIt last, int k, Compare comp = Compare(), Projection proj = Projection())
+{
+   assert(0 <= k && k < last - first);
+   RandomIt target = first + k;
+   int64_t work_left = int64_t(INTROSELECT_WORK_FACTOR) * (last - first);
+
+   while (last - first > INSERTION_SORT_CUTOFF)
+   {
+      if ((work_left -= last - first) < 0)
+      {
+         selectMedianOfMedians(first, last, target - first, comp, proj);
+         return target;
+      }
+
+      iter_swap(first, chooseMedianOfThree(first, first + (last - first) / 2, last - 1, comp, proj));
+      auto sides = partitionThreeWay(first, last, comp, proj);
+      if (target < sides.first)
+         last = sides.first;
+      else if (target < sides.second)
+         return target;
+      else
+         first = sides.second;
+   }
+
+   insertionSort(first, last, comp, proj);
+   return target;
+}
+
+template <typename RandomIt, typename Compare, typename Projection>
+void multiSelectLoop(RandomIt begin, RandomIt first, RandomIt last, vector<int>::const_iterator ranks_first, vector<int>::const_iterator ranks_last,
+                     int depth_limit, Compare &comp, Projection &proj)
+{
+   while (ranks_first != ranks_last)
+   {
+      if (last - first <= INSERTION_SORT_CUTOFF)
+      {
+         insertionSort(first, last, comp, proj);
+         return;
+      }
+
+      RandomIt pivot = depth_limit-- > 0 ? chooseMedianOfThree(first, first + (last - first) / 2, last - 1, comp, proj) : medianOfMedians(first, last, comp, proj);
+      iter_swap(first, pivot);
+      auto sides = partitionThreeWay(first, last, comp, proj);
+
+      // The ranks before the equal elements are left to the lesser side, the ones among them are done, and the ones
+      // after them are left to the greater side
+      auto ranks_equal = lower_bound(ranks_first, ranks_last, sides.first - begin);
+      auto ranks_greater = lower_bound(ranks_equal, ranks_last, sides.second - begin);
+      multiSelectLoop(begin, first, sides.first, ranks_first, ranks_equal, depth_limit, comp, proj);
+      first = sides.second;
+      ranks_first = ranks_greater;
+   }
+}
+
+// Puts the k-th smallest element of [first, last) at first + k for every k in ranks, with no greater elements before it
+// and no lesser ones after it, in a single quickselect that carries on into every side holding one of the ranks. The
+// partitions near the top serve all the ranks at once, so selecting r ranks takes O(n log r) on average rather than
+// the O(n r) of r separate selections. Pivots are medians of three up to a depth of 2 log n, then medians of medians
+template <typename RandomIt, typename Compare = less<>, typename Projection = Identity>
+void multiSelect(RandomIt first, RandomIt last, vector<int> ranks, Compare comp = Compare(), Projection proj = Projection())
+{
+   sort(ranks.begin(), ranks.end());
+   ranks.erase(unique(ranks.begin(), ranks.end()), ranks.end());
+   assert(ranks.empty() || (ranks.front() >= 0 && ranks.back() < last - first));
+   if (ranks.empty())
+      return;
+
+   multiSelectLoop(first, first, last, ranks.cbegin(), ranks.cend(), 2 * int(log2(last - first)), comp, proj);
+}
+
+int randomizedSelect(vector<int> &v, int k, mt19937 &rng)
+{
+   return *randomizedSelect(v.begin(), v.end(), k, rng);
+}
+
+int introSelect(vector<int> &v, int k)
+{
+   return *introSelect(v.begin(), v.end(), k);
+}
+
+// The elements of the given ranks, in the order of ranks
+vector<int> multiSelect(vector<int> &v, vector<int> const &ranks)
+{
+   multiSelect(v.begin(), v.end(), ranks);
+   vector<int> selected;
+   for (int k : ranks)
+      selected.push_back(v[k]);
+   return selected;
+}
+
+// The k largest elements of v, largest first: a selection of the k-th largest brings them to the front, and then only
+// they are sorted
+vector<int> topK(vector<int> v, int k)
+{
+   k = min<int>(k, v.size());
+   if (k == 0)
+      return {};
+
+   introSelect(v.begin(), v.end(), k - 1, greater<>());
+   sort(v.begin(), v.begin() + k, greater<>());
+   v.resize(k);
+   return v;
+}
+#pragma endregion
+
+int main()
+{
+   // Find all test case files (courtesy of https://stackoverflow.com/a/612176/3477043)
+   vector<string> test_case_files;
+   DIR *dir;
+   struct dirent *ent;
+   string const TESTDIR = "./testcases";
+   if ((dir = opendir(TESTDIR.c_str())) != nullptr)
+   {
+      while ((ent = readdir(dir)) != nullptr)
+         if (ent->d_name[0] != '.')
+            test_case_files.push_back(ent->d_name); // assumes that the file is not a dir
+      closedir(dir);
+   }
+   else
+   {
+      // Could not open directory
+      perror("");
+      return EXIT_FAILURE;
+   }
+
+   // Sort them
+   sort(test_case_files.begin(), test_case_files.end());
+
+   // For each case, read the file and select its minimum, median and maximum, and a few more ranks at once
+   mt19937 rng(25);
+   int const n_start = 1, n = test_case_files.size();
+   for (auto it = test_case_files.begin() + n_start - 1; it != test_case_files.begin() + n_start - 1 + n; ++it)
+   {
+      string const &filename = *it;
+      string const filepath = TESTDIR + "/" + filename;
+      vector<int> test_case;
+      ifstream file(filepath);
+      int x;
+      while (file >> x)
+         test_case.push_back(x);
+
+      cout << filename << ":" << endl;
+      int size = test_case.size();
+      if (size == 0)
+      {
+         cout << "; " << endl;
+         continue;
+      }
+
+      vector<int> ranks = {0, (size - 1) / 2, size - 1};
+      vector<int> randomized, intro, multi = test_case;
+      for (int k : ranks)
+      {
+         auto selected = test_case; // make a copy
+         randomized.push_back(randomizedSelect(selected, k, rng));
+         bool selectedCorrectly = verify(selected, test_case, {k});
+         selected = test_case;
+         intro.push_back(introSelect(selected, k));
+         if (!selectedCorrectly || !verify(selected, test_case, {k}) || randomized.back() != intro.back())
+            cout << "(FAILED!) ";
+      }
+      cout << "Minimum, median, maximum;" << intro << endl;
+
+      vector<int> many_ranks = {size / 10, size / 3, (size - 1) / 2, size - 1, 0, size / 3};
+      vector<int> selected = multiSelect(multi, many_ranks);
+      vector<int> sorted = test_case;
+      sort(sorted.begin(), sorted.end());
+      bool multiSelectedCorrectly = verify(multi, test_case, many_ranks);
+      for (int i = 0; i < many_ranks.size(); ++i)
+         multiSelectedCorrectly = multiSelectedCorrectly && selected[i] == sorted[many_ranks[i]];
+      cout << "Multi-select;" << (multiSelectedCorrectly ? "" : "(FAILED!) ") << selected << endl;
+
+      vector<int> top = topK(test_case, 5);
+      bool topCorrectly = equal(top.begin(), top.end(), sorted.rbegin());
+      cout << "Top 5;" << (topCorrectly ? "" : "(FAILED!) ") << top << endl;
+      cout << "; " << endl;
+   }
+
+   // Every rank of every size up to a few hundred, with keys from all distinct to all equal, by every engine
+   {
+      bool success = true;
+      for (int n = 1; n < 300; n += (n < 40 ? 1 : 13))
+         for (int distinct : {1, 3, 100, INT32_MAX})
+         {
+            vector<int> v(n);
+            for (int &x : v)
+               x = int(rng() % distinct);
+            for (int k = 0; k < n; ++k)
+            {
+               auto randomized = v, intro = v, median_of_medians = v;
+               randomizedSelect(randomized, k, rng);
+               introSelect(intro, k);
+               Identity identity;
+               less<> comp;
+               selectMedianOfMedians(median_of_medians.begin(), median_of_medians.end(), k, comp, identity);
+               success = success && verify(randomized, v, {k}) && verify(intro, v, {k}) && verify(median_of_medians, v, {k});
+            }
+         }
+      cout << "Every rank; " << (success ? "selected by every engine" : "(FAILED!)") << endl;
+   }
+
+   // The median of large inputs of various shapes, timed against std::nth_element and a full sort, with the comparisons
+   // introSelect() makes per element, which stay bounded however the input is shaped
+   {
+      int n = 1 << 24;
+      vector<pair<string, vector<int>>> inputs = {{"random", vector<int>(n)}, {"sorted", vector<int>(n)}, {"organ pipe", vector<int>(n)},
+                                                   {"few distinct", vector<int>(n)}};
+      for (int i = 0; i < n; ++i)
+      {
+         inputs[0].second[i] = int(rng());
+         inputs[1].second[i] = i;
+         inputs[2].second[i] = min(i, n - i);
+         inputs[3].second[i] = int(rng() % 16);
+      }
+
+      int k = n / 2;
+      for (auto const &input : inputs)
+      {
+         auto timed = [&](auto select) {
+            auto v = input.second;
+            auto start = chrono::steady_clock::now();
+            int selected = select(v);
+            auto end = chrono::steady_clock::now();
+            return make_pair(selected, chrono::duration<double, milli>(end - start).count());
+         };
+         auto sorted = timed([&](vector<int> &v) { sort(v.begin(), v.end()); return v[k]; });
+         auto nth = timed([&](vector<int> &v) { nth_element(v.begin(), v.begin() + k, v.end()); return v[k]; });
+         auto randomized = timed([&](vector<int> &v) { return randomizedSelect(v, k, rng); });
+         auto intro = timed([&](vector<int> &v) { return introSelect(v, k); });
+         int64_t comparisons = 0;
+         auto counted = timed([&](vector<int> &v) {
+            return *introSelect(v.begin(), v.end(), k, [&](int a, int b) { ++comparisons; return a < b; });
+         });
+
+         bool success = nth.first == sorted.first && randomized.first == sorted.first && intro.first == sorted.first && counted.first == sorted.first;
+         cout << "Median; " << input.first << ", " << n << " elements; " << (success ? "" : "(FAILED!) ") << "sort " << sorted.second << " ms, nth_element "
+              << nth.second << " ms, randomized " << randomized.second << " ms, introselect " << intro.second << " ms with "
+              << double(comparisons) / n << " comparisons per element" << endl;
+      }
+   }
+
+   return 0;
+}
@@ -12,6 +12,11 @@
 #include <cassert>
 #include <vector>
 #include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <random>
+#include <type_traits>
 
 using namespace std;
 
@@ -55,10 +60,11 @@ bool verify(vector<int> const &sorted, vector<int> const &original)
 }
 #pragma endregion
 
-template <typename T>
+template <typename T, typename Compare = less<T>>
 class MinHeap
 {
    vector<T> elements;
+   Compare less_than; // the order of the heap; the root is the element no other one is less than
 
    int GetParentIndex(int i) const
    {
@@ -92,11 +98,14 @@ class MinHeap
 
       int right_index = GetRightChildIndex(i);
 
-      return elements[i] <= elements[left_index] && 
-            (right_index == -1 || elements[i] <= elements[right_index]);
+      return !less_than(elements[left_index], elements[i]) && 
+            (right_index == -1 || !less_than(elements[right_index], elements[i]));
    }
 
 public:
+   MinHeap(Compare _less_than = Compare()) : less_than(_less_than)
+   { /* nothing */ }
+
    size_t size() const
    {
       return elements.size();
@@ -116,9 +125,7 @@ public:
             break;
 
          // Swap with the parent and keep going
-         T temp = elements[i];
-         elements[i] = elements[parent_index];
-         elements[parent_index] = temp;
+         swap(elements[i], elements[parent_index]);
          i = parent_index;
       }
    }
@@ -130,21 +137,19 @@ public:
 
       // Dev time assert: Root is the true minimum
       {
-         int minimum = elements[0];
+         int minimum = 0;
          for (int i = 1; i < elements.size(); ++i)
-            if (elements[i] < minimum)
-               minimum = elements[i];
+            if (less_than(elements[i], elements[minimum]))
+               minimum = i;
 
-         assert(elements[0] == minimum);
+         assert(!less_than(elements[minimum], elements[0]));
       }
 
       // Swap root (min element) with last element in the last level of the heap tree
-      T temp = elements[0];
-      elements[0] = elements[n-1];
-      elements[n-1] = temp;
+      swap(elements[0], elements[n-1]);
 
       // Delete the min (now the last element) from the tree, keep it aside to return
-      T minimum = elements[n-1];
+      T minimum = move(elements[n-1]);
       elements.pop_back();
       --n;
 
@@ -155,10 +160,8 @@ public:
          int right_index = GetRightChildIndex(i);
 
          // Swap with the smallest of the two children and try again
-         int swap_index = right_index == -1 ? left_index : (elements[left_index] < elements[right_index] ? left_index : right_index);
-         T temp = elements[i];
-         elements[i] = elements[swap_index];
-         elements[swap_index] = temp;
+         int swap_index = right_index == -1 ? left_index : (less_than(elements[left_index], elements[right_index]) ? left_index : right_index);
+         swap(elements[i], elements[swap_index]);
          i = swap_index;
       }
 
@@ -167,16 +170,64 @@ public:
    }
 };
 
+// Projection that leaves the elements as they are
+struct Identity
+{
+   template <typename T>
+   T &&operator()(T &&x) const
+   {
+      return forward<T>(x);
+   }
+};
+
+// Sorts [first, last) by comp on the projections of the elements, e.g.
+//    heapSort(records.begin(), records.end(), less<>(), [](Record const &r) { return r.key; });
+template <typename RandomIt, typename Compare = less<>, typename Projection = Identity>
+void heapSort(RandomIt first, RandomIt last, Compare comp = Compare(), Projection proj = Projection())
+{
+   typedef typename iterator_traits<RandomIt>::value_type T;
+   auto less_than = [&](T const &a, T const &b) { return comp(proj(a), proj(b)); };
+   MinHeap<T, decltype(less_than)> heap(less_than);
+
+   for (RandomIt it = first; it != last; ++it)
+      heap.Insert(*it);
+
+   for (RandomIt it = first; heap.size() > 0; ++it)
+      *it = heap.ExtractMin();
+}
+
 void heapSort(vector<int> &numbers)
 {
-   MinHeap<int> heap;
+   heapSort(numbers.begin(), numbers.end());
+}
 
-   for (auto x : numbers)
-      heap.Insert(x);
+// Moves the elements of [first, first + order.size()) so that element order[i].second comes i-th
+template <typename RandomIt, typename Key>
+void applyOrder(RandomIt first, vector<pair<Key, int>> const &order)
+{
+   vector<typename iterator_traits<RandomIt>::value_type> sorted;
+   sorted.reserve(order.size());
+   for (auto const &entry : order)
+      sorted.push_back(move(first[entry.second]));
+   move(sorted.begin(), sorted.end(), first);
+}
 
-   int n = numbers.size();
-   for (int i = 0; heap.size() > 0; ++i)
-      numbers[i] = heap.ExtractMin();
+// Key-value mode: sorts [first, last) by comp on key(element), for elements that are expensive to move. Only (key, index)
+// pairs go through the heap, and then every element is moved once to its place. Equal keys are ordered by index, so unlike
+// the plain heapSort() this is stable
+template <typename RandomIt, typename KeyFunction, typename Compare = less<>>
+void heapSortByKey(RandomIt first, RandomIt last, KeyFunction key, Compare comp = Compare())
+{
+   typedef decay_t<decltype(key(*first))> Key;
+   vector<pair<Key, int>> order;
+   order.reserve(last - first);
+   for (RandomIt it = first; it != last; ++it)
+      order.push_back({key(*it), int(it - first)});
+
+   heapSort(order.begin(), order.end(), [&](pair<Key, int> const &a, pair<Key, int> const &b) {
+      return comp(a.first, b.first) || (!comp(b.first, a.first) && a.second < b.second);
+   });
+   applyOrder(first, order);
 }
 
 int main()
@@ -190,6 +241,33 @@ int main()
    // Sort them
    sort(test_case_files.begin(), test_case_files.end());
 
+   // Records sorted through the generic API, by a projected key in descending order and in key-value mode, checked against
+   // std::stable_sort
+   {
+      struct Record
+      {
+         int64_t key;
+         string payload;
+      };
+      mt19937 rng(15);
+      vector<Record> records;
+      for (int i = 0; i < 1000; ++i)
+         records.push_back({int64_t(rng() % 50) << 40, "record " + to_string(i)});
+      auto key = [](Record const &r) { return r.key; };
+
+      vector<Record> expected = records, by_key = records;
+      stable_sort(expected.begin(), expected.end(), [](Record const &a, Record const &b) { return a.key < b.key; });
+      heapSortByKey(by_key.begin(), by_key.end(), key);
+      vector<Record> expected_descending = records, descending = records;
+      stable_sort(expected_descending.begin(), expected_descending.end(), [](Record const &a, Record const &b) { return a.key > b.key; });
+      heapSort(descending.begin(), descending.end(), greater<>(), key);
+
+      bool success = true;
+      for (int i = 0; i < records.size(); ++i)
+         success = success && by_key[i].key == expected[i].key && by_key[i].payload == expected[i].payload && descending[i].key == expected_descending[i].key;
+      cout << "Generic API: " << (success ? "records sorted by key descending and in key-value mode" : "(FAILED!)") << endl << endl;
+   }
+
    int const n_start = 1, n = test_case_files.size();
    for (auto it = test_case_files.begin() + n_start - 1; it != test_case_files.begin() + n_start - 1 + n; ++it)
    {